@@ -0,0 +1,86 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/benchmark/CMakeLists.txt"
+  "/root/repo/example/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/TBB/TBBTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "example/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/style.dir/DependInfo.cmake"
+  "example/CMakeFiles/combined.dir/DependInfo.cmake"
+  "example/CMakeFiles/concepts.dir/DependInfo.cmake"
+  "example/CMakeFiles/container.dir/DependInfo.cmake"
+  "example/CMakeFiles/drawable.dir/DependInfo.cmake"
+  "example/CMakeFiles/forward.dir/DependInfo.cmake"
+  "example/CMakeFiles/function.dir/DependInfo.cmake"
+  "example/CMakeFiles/injection.dir/DependInfo.cmake"
+  "example/CMakeFiles/macro.dir/DependInfo.cmake"
+  "example/CMakeFiles/nonowning.dir/DependInfo.cmake"
+  "example/CMakeFiles/overload.dir/DependInfo.cmake"
+  "example/CMakeFiles/override.dir/DependInfo.cmake"
+  "example/CMakeFiles/storage.dir/DependInfo.cmake"
+  "example/CMakeFiles/unified.dir/DependInfo.cmake"
+  "test/CMakeFiles/te.dir/DependInfo.cmake"
+  "test/CMakeFiles/allocations.dir/DependInfo.cmake"
+  "test/CMakeFiles/poly_collection.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_closed.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_collection.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_construction.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_footprint.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_function.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_grouped.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_pool.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_suite.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_compile_time.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/benchmark_code_size.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_closed.dir/closed.cpp.o"
+  "CMakeFiles/benchmark_closed.dir/closed.cpp.o.d"
+  "benchmark_closed"
+  "benchmark_closed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_closed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
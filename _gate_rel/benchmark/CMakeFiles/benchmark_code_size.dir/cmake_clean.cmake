@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_code_size"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/benchmark_code_size.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
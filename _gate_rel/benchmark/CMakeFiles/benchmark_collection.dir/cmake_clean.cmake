@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_collection.dir/collection.cpp.o"
+  "CMakeFiles/benchmark_collection.dir/collection.cpp.o.d"
+  "benchmark_collection"
+  "benchmark_collection.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_collection.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_construction.dir/construction.cpp.o"
+  "CMakeFiles/benchmark_construction.dir/construction.cpp.o.d"
+  "benchmark_construction"
+  "benchmark_construction.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_construction.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
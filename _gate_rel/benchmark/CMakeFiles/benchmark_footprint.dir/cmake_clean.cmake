@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_footprint.dir/footprint.cpp.o"
+  "CMakeFiles/benchmark_footprint.dir/footprint.cpp.o.d"
+  "benchmark_footprint"
+  "benchmark_footprint.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_footprint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_function.dir/function.cpp.o"
+  "CMakeFiles/benchmark_function.dir/function.cpp.o.d"
+  "benchmark_function"
+  "benchmark_function.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_function.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_grouped.dir/grouped.cpp.o"
+  "CMakeFiles/benchmark_grouped.dir/grouped.cpp.o.d"
+  "benchmark_grouped"
+  "benchmark_grouped.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_grouped.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
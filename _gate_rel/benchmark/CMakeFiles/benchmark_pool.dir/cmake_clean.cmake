@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmark_pool.dir/pool.cpp.o"
+  "CMakeFiles/benchmark_pool.dir/pool.cpp.o.d"
+  "benchmark_pool"
+  "benchmark_pool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
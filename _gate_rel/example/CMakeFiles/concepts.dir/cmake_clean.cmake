@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/concepts.dir/concepts.cpp.o"
+  "CMakeFiles/concepts.dir/concepts.cpp.o.d"
+  "concepts"
+  "concepts.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/concepts.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/container.dir/container.cpp.o"
+  "CMakeFiles/container.dir/container.cpp.o.d"
+  "container"
+  "container.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/container.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/drawable.dir/drawable.cpp.o"
+  "CMakeFiles/drawable.dir/drawable.cpp.o.d"
+  "drawable"
+  "drawable.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/drawable.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/forward.dir/forward.cpp.o"
+  "CMakeFiles/forward.dir/forward.cpp.o.d"
+  "forward"
+  "forward.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/forward.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/function.dir/function.cpp.o"
+  "CMakeFiles/function.dir/function.cpp.o.d"
+  "function"
+  "function.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/function.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/injection.dir/injection.cpp.o"
+  "CMakeFiles/injection.dir/injection.cpp.o.d"
+  "injection"
+  "injection.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/injection.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/macro.dir/macro.cpp.o"
+  "CMakeFiles/macro.dir/macro.cpp.o.d"
+  "macro"
+  "macro.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/macro.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nonowning.dir/nonowning.cpp.o"
+  "CMakeFiles/nonowning.dir/nonowning.cpp.o.d"
+  "nonowning"
+  "nonowning.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nonowning.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/override.dir/override.cpp.o"
+  "CMakeFiles/override.dir/override.cpp.o.d"
+  "override"
+  "override.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/override.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/storage.dir/storage.cpp.o"
+  "CMakeFiles/storage.dir/storage.cpp.o.d"
+  "storage"
+  "storage.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/storage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
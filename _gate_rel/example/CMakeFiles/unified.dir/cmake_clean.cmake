@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unified.dir/unified.cpp.o"
+  "CMakeFiles/unified.dir/unified.cpp.o.d"
+  "unified"
+  "unified.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unified.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/allocations.dir/allocations.cpp.o"
+  "CMakeFiles/allocations.dir/allocations.cpp.o.d"
+  "allocations"
+  "allocations.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/allocations.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/poly_collection.dir/poly_collection.cpp.o"
+  "CMakeFiles/poly_collection.dir/poly_collection.cpp.o.d"
+  "CMakeFiles/poly_collection.dir/poly_collection_other.cpp.o"
+  "CMakeFiles/poly_collection.dir/poly_collection_other.cpp.o.d"
+  "poly_collection"
+  "poly_collection.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/poly_collection.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/te.dir/te.cpp.o"
+  "CMakeFiles/te.dir/te.cpp.o.d"
+  "te"
+  "te.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/te.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
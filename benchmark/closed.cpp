@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <variant>
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+struct Square {
+  double area() const { return side * side; }
+  double side{};
+};
+
+struct Circle {
+  double area() const { return 3.14 * radius * radius; }
+  double radius{};
+};
+
+struct Triangle {
+  double area() const { return base * height / 2; }
+  double base{};
+  double height{};
+};
+
+struct Shape {
+  double area() const {
+    return te::call<double>([](auto const &self) { return self.area(); },
+                            *this);
+  }
+};
+
+struct ClosedShape : te::closed_poly<ClosedShape, Square, Circle, Triangle> {
+  using te::closed_poly<ClosedShape, Square, Circle, Triangle>::closed_poly;
+
+  double area() const {
+    return te::call<double>([](auto const &self) { return self.area(); },
+                            *this);
+  }
+};
+
+using variant_t = std::variant<Square, Circle, Triangle>;
+
+template <class T>
+std::vector<T> make_shapes() {
+  std::vector<T> shapes{};
+  auto seed = 42u;
+  for (auto i = 0; i < 1'000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    switch ((seed >> 16) % 3) {
+      case 0:
+        shapes.push_back(Square{double(i)});
+        break;
+      case 1:
+        shapes.push_back(Circle{double(i)});
+        break;
+      default:
+        shapes.push_back(Triangle{double(i), 2});
+        break;
+    }
+  }
+  return shapes;
+}
+
+template <class T, class F>
+void total_area(const char *name, F area) {
+  constexpr auto rounds = std::size_t{10'000};
+  const auto shapes = make_shapes<T>();
+
+  measure(name, rounds * shapes.size(), [&](std::size_t) {
+    for (auto round = 0u; round < rounds; ++round) {
+      auto total = 0.;
+      for (const auto &shape : shapes) {
+        total += area(shape);
+      }
+      do_not_optimize(total);
+    }
+  });
+}
+
+benchmark closed_dispatch = [] {
+  total_area<te::poly<Shape, te::local_storage<16>>>(
+      "poly<local_storage<16>>", [](const auto &shape) { return shape.area(); });
+  total_area<te::closed_poly<Shape, Square, Circle, Triangle>>(
+      "closed_poly (vtable)", [](const auto &shape) { return shape.area(); });
+  total_area<ClosedShape>("closed_poly (switch)",
+                          [](const auto &shape) { return shape.area(); });
+  total_area<variant_t>("std::variant + std::visit", [](const auto &shape) {
+    return std::visit([](const auto &self) { return self.area(); }, shape);
+  });
+};
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "boost/te.hpp"
+
+namespace te = boost::te;
+
+#if not defined(STORAGE)
+#define STORAGE te::sbo_storage<32>
+#endif
+
+#if not defined(HANDLERS)
+#define HANDLERS 100
+#endif
+
+struct Handler {
+  void handle(int event) {
+    te::call([](auto &self, int event) { self.handle(event); }, *this, event);
+  }
+};
+
+/*! Each one is a distinct erased type with its own lifecycle thunks !*/
+template <std::size_t N>
+struct Implementation {
+  void handle(int event) { name += std::to_string(event + int(N)); }
+  std::string name{};
+};
+
+template <std::size_t... Ns>
+auto handlers(std::index_sequence<Ns...>) {
+  std::vector<te::poly<Handler, STORAGE>> handlers{};
+  (handlers.emplace_back(Implementation<Ns>{}), ...);
+  return handlers;
+}
+
+int main(int argc, char **) {
+  auto all = handlers(std::make_index_sequence<HANDLERS>{});
+  for (auto &handler : all) {
+    handler.handle(argc);
+  }
+}
@@ -0,0 +1,8 @@
+#
+# Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+file(SIZE ${OBJECT} size)
+message("${NAME} ${size} bytes")
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+struct Square {
+  double area() const { return side * side; }
+  double side{};
+};
+
+struct Circle {
+  double area() const { return 3.14 * radius * radius; }
+  double radius{};
+};
+
+struct Triangle {
+  double area() const { return base * height / 2; }
+  double base{};
+  double height{};
+};
+
+struct Shape {
+  double area() const {
+    return te::call<double>([](auto const &self) { return self.area(); },
+                            *this);
+  }
+};
+
+template <class F>
+void fill(F add) {
+  auto seed = 42u;
+  for (auto i = 0; i < 1'000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    switch ((seed >> 16) % 3) {
+      case 0:
+        add(Square{double(i)});
+        break;
+      case 1:
+        add(Circle{double(i)});
+        break;
+      default:
+        add(Triangle{double(i), 2});
+        break;
+    }
+  }
+}
+
+constexpr auto rounds = std::size_t{10'000};
+
+benchmark collection_dispatch = [] {
+  {
+    std::vector<te::poly<Shape, te::local_storage<16>>> shapes{};
+    fill([&](auto shape) { shapes.push_back(shape); });
+    measure("std::vector<poly<local_storage<16>>>", rounds * shapes.size(),
+            [&](std::size_t) {
+              for (auto round = 0u; round < rounds; ++round) {
+                auto total = 0.;
+                for (const auto &shape : shapes) {
+                  total += shape.area();
+                }
+                do_not_optimize(total);
+              }
+            });
+  }
+
+  {
+    std::vector<te::poly<Shape>> shapes{};
+    fill([&](auto shape) { shapes.push_back(shape); });
+    measure("std::vector<poly<dynamic_storage>>", rounds * shapes.size(),
+            [&](std::size_t) {
+              for (auto round = 0u; round < rounds; ++round) {
+                auto total = 0.;
+                for (const auto &shape : shapes) {
+                  total += shape.area();
+                }
+                do_not_optimize(total);
+              }
+            });
+  }
+
+  {
+    te::poly_collection<Shape> shapes{};
+    fill([&](auto shape) { shapes.insert(shape); });
+    measure("poly_collection::for_each", rounds * shapes.size(),
+            [&](std::size_t) {
+              for (auto round = 0u; round < rounds; ++round) {
+                auto total = 0.;
+                shapes.for_each([](auto const &self,
+                                   auto &total) { total += self.area(); },
+                                total);
+                do_not_optimize(total);
+              }
+            });
+  }
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+template <class T>
+inline void do_not_optimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/*! Results are printed as they come, or as json/csv at exit when
+ *  TE_BENCHMARK_FORMAT is set accordingly !*/
+class results {
+ public:
+  struct result {
+    std::string name;
+    double value;
+    const char *unit;
+  };
+
+  static void add(const char *name, double value, const char *unit) {
+    if (format() == text) {
+      std::printf("%-48s %12.3f %s\n", name, value, unit);
+    } else {
+      all().push_back({name, value, unit});
+    }
+  }
+
+  static void flush() {
+    if (format() == json) {
+      std::printf("[\n");
+      for (auto i = 0u; i < all().size(); ++i) {
+        std::printf("  {\"name\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}%s\n",
+                    escape(all()[i].name, '\\').c_str(), all()[i].value,
+                    all()[i].unit, i + 1 < all().size() ? "," : "");
+      }
+      std::printf("]\n");
+    } else if (format() == csv) {
+      std::printf("name,value,unit\n");
+      for (const auto &result : all()) {
+        std::printf("\"%s\",%.3f,%s\n", escape(result.name, '"').c_str(),
+                    result.value, result.unit);
+      }
+    }
+  }
+
+ private:
+  enum format_t { text, json, csv };
+
+  static format_t format() {
+    static const auto format = [] {
+      const auto *env = std::getenv("TE_BENCHMARK_FORMAT");
+      if (env and not std::strcmp(env, "json")) return json;
+      if (env and not std::strcmp(env, "csv")) return csv;
+      return text;
+    }();
+    return format;
+  }
+
+  static std::string escape(const std::string &name, char escape) {
+    std::string escaped{};
+    for (auto c : name) {
+      if (c == '"' or c == escape) escaped += escape;
+      escaped += c;
+    }
+    return escaped;
+  }
+
+  static std::vector<result> &all() {
+    static std::vector<result> results{};
+    return results;
+  }
+};
+
+/*! Runs fn(iterations) and reports the average time per iteration in ns !*/
+template <class Fn>
+double measure(const char *name, std::size_t iterations, const Fn &fn) {
+  const auto start = std::chrono::steady_clock::now();
+  fn(iterations);
+  const auto stop = std::chrono::steady_clock::now();
+  const auto ns =
+      std::chrono::duration<double, std::nano>(stop - start).count() /
+      static_cast<double>(iterations);
+  results::add(name, ns, "ns/op");
+  return ns;
+}
+
+struct benchmark {
+  template <class Benchmark>
+  benchmark(const Benchmark &benchmark) {
+    benchmark();
+  }
+};
+
+int main() { results::flush(); }
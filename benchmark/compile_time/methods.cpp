@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <utility>
+
+#include "boost/te.hpp"
+
+namespace te = boost::te;
+
+#if not defined(METHODS)
+#define METHODS 10
+#endif
+
+/*! Every instantiation of call is a distinct method of the interface !*/
+template <std::size_t Id>
+struct Interface {
+  template <std::size_t N>
+  auto call(std::integral_constant<std::size_t, N>) const {
+    return te::call<std::size_t>(
+        [](auto const &self) { return self.template call<N>(); }, *this);
+  }
+};
+
+struct Implementation {
+  template <std::size_t N>
+  std::size_t call() const {
+    return N;
+  }
+};
+
+template <std::size_t Id, std::size_t... Ns>
+std::size_t call_all(std::index_sequence<Ns...>) {
+  te::poly<Interface<Id>> poly{Implementation{}};
+  return (poly.call(std::integral_constant<std::size_t, Ns>{}) + ...);
+}
+
+template <std::size_t... Ids>
+std::size_t interfaces(std::index_sequence<Ids...>) {
+  return (call_all<Ids>(std::make_index_sequence<METHODS>{}) + ...);
+}
+
+int main() {
+  return interfaces(std::make_index_sequence<4>{}) ==
+                 4 * METHODS * (METHODS - 1) / 2
+             ? 0
+             : 1;
+}
@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+struct Drawable {
+  void draw(std::ostream &out) const {
+    te::call([](auto const &self, auto &out) { self.draw(out); }, *this, out);
+  }
+};
+
+struct Square {
+  void draw(std::ostream &out) const { out << "Square"; }
+};
+
+template <class TPoly>
+void construct_in_parallel(const char *name, std::size_t threads) {
+  constexpr auto iterations = std::size_t{1'000'000};
+  const auto label = std::string{name} + " x" + std::to_string(threads);
+
+  measure(label.c_str(), iterations * threads, [&](std::size_t) {
+    std::vector<std::thread> workers{};
+    for (auto i = 0u; i < threads; ++i) {
+      workers.emplace_back([] {
+        for (auto n = 0u; n < iterations; ++n) {
+          TPoly drawable{Square{}};
+          do_not_optimize(drawable);
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  });
+}
+
+benchmark construction_scaling = [] {
+  for (auto threads : {1u, 2u, 4u, 8u}) {
+    construct_in_parallel<te::poly<Drawable, te::local_storage<8>>>(
+        "poly<local_storage<8>>", threads);
+  }
+  for (auto threads : {1u, 2u, 4u, 8u}) {
+    construct_in_parallel<te::poly<Drawable>>("poly<dynamic_storage>",
+                                              threads);
+  }
+};
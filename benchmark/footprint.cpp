@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+static std::size_t allocated_bytes = 0;
+
+void *operator new(std::size_t size) {
+  allocated_bytes += size;
+  if (auto ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+struct Drawable {
+  void draw(std::ostream &out) const {
+    te::call([](auto const &self, auto &out) { self.draw(out); }, *this, out);
+  }
+};
+
+struct Square {
+  void draw(std::ostream &out) const { out << "Square " << side; }
+  double side{};
+};
+
+template <class TPoly>
+void footprint(const char *name) {
+  constexpr auto elements = std::size_t{1'000'000};
+
+  allocated_bytes = 0;
+  {
+    std::vector<TPoly> drawables{};
+    drawables.reserve(elements);
+    for (auto i = 0u; i < elements; ++i) {
+      drawables.emplace_back(Square{double(i)});
+    }
+    do_not_optimize(drawables.data());
+  }
+
+  results::add((std::string{name} + " sizeof").c_str(), sizeof(TPoly), "bytes");
+  results::add((std::string{name} + " allocated").c_str(),
+               double(allocated_bytes) / elements, "bytes/element");
+}
+
+benchmark memory_footprint = [] {
+  footprint<te::poly<Drawable, te::dynamic_storage>>("poly<dynamic_storage>");
+  footprint<te::poly<Drawable, te::shared_storage>>("poly<shared_storage>");
+  footprint<te::poly<Drawable, te::local_storage<16>>>(
+      "poly<local_storage<16>>");
+  footprint<te::poly<Drawable, te::sbo_storage<16>>>("poly<sbo_storage<16>>");
+  footprint<te::poly<Drawable, te::sbo_storage<4>>>(
+      "poly<sbo_storage<4>> (heap)");
+  footprint<te::poly<Drawable, te::unique_storage>>("poly<unique_storage>");
+  footprint<te::poly<Drawable, te::unique_sbo_storage<16>>>(
+      "poly<unique_sbo_storage<16>>");
+
+  results::add("sbo_storage<16> table", sizeof(te::sbo_storage<16>::ops_t),
+               "bytes/type");
+  results::add("unique_sbo_storage<16> table",
+               sizeof(te::unique_sbo_storage<16>::ops_t), "bytes/type");
+  results::add("dynamic_storage table", sizeof(te::dynamic_storage::ops_t),
+               "bytes/type");
+  results::add("unique_storage table", sizeof(te::unique_storage::ops_t),
+               "bytes/type");
+};
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <array>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+struct Callable {
+  int operator()(int i) {
+    return te::call<int>([](auto &self, int i) { return self(i); }, *this, i);
+  }
+};
+
+struct Small {
+  int operator()(int i) const { return i + value; }
+  int value{};
+};
+
+struct Large {
+  int operator()(int i) const { return i + values[std::size_t(i) & 7]; }
+  std::array<int, 8> values{};
+};
+
+template <class TFunction, class T>
+void invoke(const char *name) {
+  constexpr auto size = std::size_t{1'000};
+  constexpr auto rounds = std::size_t{10'000};
+  std::vector<TFunction> functions{};
+  for (auto i = 0u; i < size; ++i) {
+    functions.push_back(TFunction{T{}});
+  }
+
+  const auto label = std::string{name} + " invoke";
+  measure(label.c_str(), rounds * size, [&](std::size_t) {
+    for (auto round = 0u; round < rounds; ++round) {
+      auto total = 0;
+      for (auto &function : functions) {
+        total += function(int(round));
+      }
+      do_not_optimize(total);
+    }
+  });
+}
+
+template <class TRef, class T>
+void invoke_ref(const char *name) {
+  constexpr auto size = std::size_t{1'000};
+  constexpr auto rounds = std::size_t{10'000};
+  std::vector<T> callables(size);
+  std::vector<TRef> refs{};
+  for (auto &callable : callables) {
+    refs.push_back(TRef{callable});
+  }
+
+  const auto label = std::string{name} + " invoke";
+  measure(label.c_str(), rounds * size, [&](std::size_t) {
+    for (auto round = 0u; round < rounds; ++round) {
+      auto total = 0;
+      for (auto ref : refs) {
+        total += ref(int(round));
+      }
+      do_not_optimize(total);
+    }
+  });
+}
+
+template <class TFunction, class T>
+void construct(const char *name) {
+  constexpr auto iterations = std::size_t{1'000'000};
+
+  const auto label = std::string{name} + " construct";
+  measure(label.c_str(), iterations, [&](std::size_t) {
+    for (auto n = 0u; n < iterations; ++n) {
+      TFunction function{T{}};
+      do_not_optimize(function);
+    }
+  });
+}
+
+template <class T>
+void compare(const char *type) {
+  const auto name = [type](const char *function) {
+    return std::string{function} + "<" + type + ">";
+  };
+  invoke<te::function<int(int)>, T>(name("te::function").c_str());
+  invoke<te::move_only_function<int(int)>, T>(
+      name("te::move_only_function").c_str());
+  invoke<std::function<int(int)>, T>(name("std::function").c_str());
+#if defined(__cpp_lib_move_only_function)
+  invoke<std::move_only_function<int(int)>, T>(
+      name("std::move_only_function").c_str());
+#endif
+  invoke_ref<te::function_ref<int(int)>, T>(name("te::function_ref").c_str());
+  invoke_ref<te::poly_ref<Callable>, T>(name("te::poly_ref").c_str());
+  invoke_ref<te::poly<Callable, te::non_owning_storage>, T>(
+      name("te::poly<non_owning_storage>").c_str());
+
+  construct<te::function<int(int)>, T>(name("te::function").c_str());
+  construct<te::move_only_function<int(int)>, T>(
+      name("te::move_only_function").c_str());
+  construct<std::function<int(int)>, T>(name("std::function").c_str());
+#if defined(__cpp_lib_move_only_function)
+  construct<std::move_only_function<int(int)>, T>(
+      name("std::move_only_function").c_str());
+#endif
+}
+
+benchmark function_vs_std = [] {
+  compare<Small>("small");
+  compare<Large>("large");
+};
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <array>
+#include <cstdio>
+#include <execution>
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+struct Particle {
+  void update() {
+    te::call([](auto &self) { self.update(); }, *this);
+  }
+};
+
+template <std::size_t N>
+struct Moving {
+  void update() { position = position * .5 + N; }
+  double position{};
+};
+
+using particle_t = te::poly<Particle>;
+
+template <std::size_t... Ns>
+constexpr auto factories(std::index_sequence<Ns...>) {
+  return std::array<particle_t (*)(), sizeof...(Ns)>{
+      [] { return particle_t{Moving<Ns>{}}; }...};
+}
+
+template <std::size_t Types>
+void update(const char *suffix) {
+  constexpr auto rounds = std::size_t{100};
+  static constexpr auto make = factories(std::make_index_sequence<Types>{});
+
+  std::vector<particle_t> particles{};
+  auto seed = 42u;
+  for (auto i = 0; i < 10'000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    particles.push_back(make[(seed >> 8) % Types]());
+  }
+
+  const auto name = [&](const char *prefix) {
+    static char buffer[64]{};
+    std::snprintf(buffer, sizeof(buffer), "%s (%s)", prefix, suffix);
+    return buffer;
+  };
+
+  measure(name("naive loop"), rounds * particles.size(), [&](std::size_t) {
+    for (auto round = 0u; round < rounds; ++round) {
+      for (auto &particle : particles) {
+        particle.update();
+      }
+    }
+  });
+
+  measure(name("grouped_for_each"), rounds * particles.size(), [&](std::size_t) {
+    for (auto round = 0u; round < rounds; ++round) {
+      te::grouped_for_each(particles, [](auto &particle) { particle.update(); });
+    }
+  });
+
+  measure(name("grouped_for_each(par)"), rounds * particles.size(), [&](std::size_t) {
+    for (auto round = 0u; round < rounds; ++round) {
+      te::grouped_for_each(std::execution::par, particles,
+                           [](auto &particle) { particle.update(); });
+    }
+  });
+}
+
+benchmark grouped_dispatch = [] {
+  update<10>("10 types");
+  update<100>("100 types");
+  update<1000>("1000 types");
+};
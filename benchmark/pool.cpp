@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <array>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+struct Drawable {
+  void draw(std::ostream &out) const {
+    te::call([](auto const &self, auto &out) { self.draw(out); }, *this, out);
+  }
+};
+
+struct Square {
+  void draw(std::ostream &out) const { out << "Square " << side; }
+  double side{};
+};
+
+struct Polygon {
+  void draw(std::ostream &out) const { out << "Polygon " << points[0]; }
+  std::array<double, 12> points{};
+};
+
+/*! Every thread keeps a window of live objects and keeps replacing them !*/
+template <class TStorage>
+void churn(const char *name, std::size_t threads) {
+  constexpr auto iterations = std::size_t{200'000};
+  const auto label = std::string{name} + " x" + std::to_string(threads);
+
+  measure(label.c_str(), iterations * threads, [&](std::size_t) {
+    std::vector<std::thread> workers{};
+    for (auto i = 0u; i < threads; ++i) {
+      workers.emplace_back([] {
+        std::array<std::optional<te::poly<Drawable, TStorage>>, 64> live{};
+        for (auto n = 0u; n < iterations; ++n) {
+          auto &slot = live[(n * 7) % live.size()];
+          if (n % 2) {
+            slot.emplace(Square{double(n)});
+          } else {
+            slot.emplace(Polygon{});
+          }
+          do_not_optimize(slot);
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  });
+}
+
+benchmark churn_heavy = [] {
+  for (auto threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    churn<te::dynamic_storage>("poly<dynamic_storage>", threads);
+    churn<te::pooled_storage>("poly<pooled_storage>", threads);
+  }
+};
@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <any>
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "boost/te.hpp"
+#include "common/benchmark.hpp"
+
+namespace te = boost::te;
+
+constexpr auto kinds = std::size_t{32};
+
+template <std::size_t N>
+struct Kind {
+  double area() const { return side * (N + 1); }
+  double side{1};
+};
+
+template <std::size_t N>
+Kind<N> instance{};
+
+struct Shape {
+  double area() const {
+    return te::call<double>([](auto const &self) { return self.area(); },
+                            *this);
+  }
+};
+
+struct Base {
+  virtual ~Base() = default;
+  virtual double area() const = 0;
+  virtual std::unique_ptr<Base> clone() const = 0;
+};
+
+template <std::size_t N>
+struct Virtual final : Base {
+  double area() const override { return kind.area(); }
+  std::unique_ptr<Base> clone() const override {
+    return std::make_unique<Virtual>(*this);
+  }
+  Kind<N> kind{};
+};
+
+template <class TStorage, class TVtable = te::static_vtable>
+struct te_model {
+  using type = te::poly<Shape, TStorage, TVtable>;
+  template <std::size_t N>
+  static type make() { return type{instance<N>}; }
+  static type copy(const type &shape) { return shape; }
+  static double area(const type &shape) { return shape.area(); }
+};
+
+struct virtual_model {
+  using type = std::unique_ptr<Base>;
+  template <std::size_t N>
+  static type make() { return std::make_unique<Virtual<N>>(); }
+  static type copy(const type &shape) { return shape->clone(); }
+  static double area(const type &shape) { return shape->area(); }
+};
+
+struct function_model {
+  using type = std::function<double()>;
+  template <std::size_t N>
+  static type make() { return [kind = instance<N>] { return kind.area(); }; }
+  static type copy(const type &shape) { return shape; }
+  static double area(const type &shape) { return shape(); }
+};
+
+template <class>
+struct variant_of;
+template <std::size_t... Ns>
+struct variant_of<std::index_sequence<Ns...>> {
+  using type = std::variant<Kind<Ns>...>;
+};
+
+struct variant_model {
+  using type = variant_of<std::make_index_sequence<kinds>>::type;
+  template <std::size_t N>
+  static type make() { return instance<N>; }
+  static type copy(const type &shape) { return shape; }
+  static double area(const type &shape) {
+    return std::visit([](const auto &self) { return self.area(); }, shape);
+  }
+};
+
+struct any_model {
+  using type = std::any;
+  template <std::size_t N>
+  static type make() { return instance<N>; }
+  static type copy(const type &shape) { return shape; }
+  static double area(const type &shape) {
+    return area(shape, std::make_index_sequence<kinds>{});
+  }
+
+ private:
+  template <std::size_t... Ns>
+  static double area(const type &shape, std::index_sequence<Ns...>) {
+    auto area = 0.;
+    void(((std::any_cast<Kind<Ns>>(&shape)
+               ? (area = std::any_cast<Kind<Ns>>(&shape)->area(), true)
+               : false) or ...));
+    return area;
+  }
+};
+
+template <class TModel, std::size_t... Ns>
+constexpr auto factories(std::index_sequence<Ns...>) {
+  return std::array<typename TModel::type (*)(), sizeof...(Ns)>{
+      &TModel::template make<Ns>...};
+}
+
+/*! 1'000 shapes of the first types, either shuffled or one type after another !*/
+template <class TModel>
+auto make_shapes(std::size_t types, bool shuffled) {
+  static constexpr auto make =
+      factories<TModel>(std::make_index_sequence<kinds>{});
+  std::vector<typename TModel::type> shapes{};
+  auto seed = 42u;
+  for (auto i = 0u; i < 1'000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    shapes.push_back(make[shuffled ? (seed >> 8) % types : i * types / 1'000]());
+  }
+  return shapes;
+}
+
+template <class TModel>
+void run(const std::string &model) {
+  constexpr auto iterations = std::size_t{1'000'000};
+  constexpr auto rounds = std::size_t{1'000};
+  const auto name = [&](const char *metric) { return model + "/" + metric; };
+
+  results::add(name("sizeof").c_str(), sizeof(typename TModel::type), "bytes");
+
+  measure(name("construct").c_str(), iterations, [](std::size_t n) {
+    for (auto i = 0u; i < n; ++i) {
+      auto shape = TModel::template make<0>();
+      do_not_optimize(shape);
+    }
+  });
+
+  measure(name("copy").c_str(), iterations, [](std::size_t n) {
+    const auto shape = TModel::template make<0>();
+    for (auto i = 0u; i < n; ++i) {
+      auto copy = TModel::copy(shape);
+      do_not_optimize(copy);
+    }
+  });
+
+  measure(name("move").c_str(), 2 * iterations, [](std::size_t n) {
+    auto shape = TModel::template make<0>();
+    for (auto i = 0u; i < n; i += 2) {
+      auto moved = std::move(shape);
+      shape = std::move(moved);
+      do_not_optimize(shape);
+    }
+  });
+
+  measure(name("call/monomorphic").c_str(), 10 * iterations, [](std::size_t n) {
+    const auto shape = TModel::template make<0>();
+    auto total = 0.;
+    for (auto i = 0u; i < n; ++i) {
+      do_not_optimize(shape);
+      total += TModel::area(shape);
+    }
+    do_not_optimize(total);
+  });
+
+  const auto calls = [&](const char *metric, std::size_t types, bool shuffled) {
+    const auto shapes = make_shapes<TModel>(types, shuffled);
+    measure(name(metric).c_str(), rounds * shapes.size(), [&](std::size_t) {
+      for (auto round = 0u; round < rounds; ++round) {
+        auto total = 0.;
+        for (const auto &shape : shapes) {
+          total += TModel::area(shape);
+        }
+        do_not_optimize(total);
+      }
+    });
+  };
+
+  calls("call/polymorphic", 4, true);
+  calls("call/megamorphic", kinds, true);
+  calls("iterate", 4, false);
+}
+
+benchmark suite = [] {
+  run<te_model<te::dynamic_storage>>("te::poly<dynamic_storage>");
+  run<te_model<te::local_storage<16>>>("te::poly<local_storage<16>>");
+  run<te_model<te::sbo_storage<16>>>("te::poly<sbo_storage<16>>");
+  run<te_model<te::shared_storage>>("te::poly<shared_storage>");
+  run<te_model<te::non_owning_storage>>("te::poly<non_owning_storage>");
+  run<te_model<te::local_storage<16>, te::instrumented_vtable<>>>(
+      "te::poly<local_storage<16>, instrumented_vtable<>>");
+  run<te_model<te::local_storage<16>, te::instrumented_vtable<64>>>(
+      "te::poly<local_storage<16>, instrumented_vtable<64>>");
+  run<virtual_model>("virtual");
+  run<function_model>("std::function");
+  run<variant_model>("std::variant");
+  run<any_model>("std::any");
+};
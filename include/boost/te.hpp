@@ -18,8 +18,27 @@
 #pragma GCC system_header
 #include <type_traits>
 #include <utility>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
 #include <stdexcept>
 #include <memory>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <string_view>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
 
 namespace boost {
 inline namespace ext {
@@ -39,19 +58,41 @@ struct mappings final {
 };
 
 template <std::size_t, class...>
-constexpr std::size_t mappings_size_impl(...) {
-  return {};
+constexpr bool is_mapped(...) {
+  return false;
 }
 
 template <std::size_t N, class T, class... Ts>
-constexpr auto mappings_size_impl(bool dummy)
-    -> decltype(get(mappings<T, N>{}), std::size_t{}) {
-  return 1 + mappings_size_impl<N + 1, T, Ts...>(dummy);
+constexpr auto is_mapped(bool) -> decltype(get(mappings<T, N>{}), bool{}) {
+  return true;
+}
+
+/*! Mappings are set contiguously from 1, Lo is mapped and Hi is not !*/
+template <std::size_t Lo, std::size_t Hi, class... Ts>
+constexpr std::size_t mappings_size_impl() {
+  if constexpr (Hi - Lo <= 1) {
+    return Lo;
+  } else if constexpr (is_mapped<Lo + (Hi - Lo) / 2, Ts...>(bool{})) {
+    return mappings_size_impl<Lo + (Hi - Lo) / 2, Hi, Ts...>();
+  } else {
+    return mappings_size_impl<Lo, Lo + (Hi - Lo) / 2, Ts...>();
+  }
+}
+
+/*! Doubles N until it's not mapped, so that the size costs log(size)
+ *  instantiations at each call site instead of size !*/
+template <std::size_t N, class... Ts>
+constexpr std::size_t mappings_bound() {
+  if constexpr (is_mapped<N, Ts...>(bool{})) {
+    return mappings_bound<2 * N, Ts...>();
+  } else {
+    return mappings_size_impl<N / 2, N, Ts...>();
+  }
 }
 
 template <class... Ts>
 constexpr auto mappings_size() {
-  return mappings_size_impl<1, Ts...>(bool{});
+  return mappings_bound<1, Ts...>();
 }
 
 template <class T, class = decltype(sizeof(T))>
@@ -78,6 +119,24 @@ class expr_wrapper final {
   }
 };
 
+template <class... Ts>
+constexpr std::size_t max_of(Ts... values) noexcept {
+  std::size_t max{};
+  ((max = values > max ? values : max), ...);
+  return max;
+}
+
+/*! Unlike std::aligned_storage, any power of two alignment is honoured !*/
+template <std::size_t Size, std::size_t Alignment>
+struct alignas(Alignment) aligned_buffer {
+  std::byte data[Size];
+};
+
+/*! Nothing converts to it, stands in for T in the copy operations of move
+ *  only types !*/
+template <class>
+struct move_only {};
+
 /*! Same as std::exchange() but is guaranteed constexpr !*/
 template<class T, class U>
 constexpr
@@ -91,6 +150,223 @@ inline T exchange(T& obj, U&& new_value)
   obj         = std::forward<U>(new_value);
   return old_value;
 }
+
+/*! Assigns an erased object to another one of the same type in place,
+ *  null when the type can't be assigned !*/
+template <class T>
+constexpr auto copy_assign_of() noexcept -> void (*)(void*, const void*) {
+  if constexpr (std::is_copy_assignable_v<T>) {
+    return [](void* self, const void* other) {
+      *static_cast<T*>(self) = *static_cast<const T*>(other);
+    };
+  } else {
+    return nullptr;
+  }
+}
+
+template <class T>
+constexpr auto move_assign_of() noexcept -> void (*)(void*, void*) {
+  if constexpr (std::is_nothrow_move_assignable_v<T>) {
+    return [](void* self, void* other) {
+      *static_cast<T*>(self) = std::move(*static_cast<T*>(other));
+    };
+  } else {
+    return nullptr;
+  }
+}
+
+/*! Types with their own operator new, whose heap blocks aren't handed
+ *  over to other types !*/
+template <class T, class = void>
+struct has_class_allocation : std::false_type {};
+
+template <class T>
+struct has_class_allocation<T, std::void_t<decltype(T::operator new(std::size_t{}))>>
+  : std::true_type {};
+}  // namespace detail
+
+/*! Erased types which can be moved with a memcpy of their bytes (the source
+ *  is then forgotten, not destroyed). Specialize to opt-in other types, types
+ *  which can't be moved aren't relocated even when trivially copyable
+ *  (std::mutex is, with some standard libraries) !*/
+template <class T>
+struct is_trivially_relocatable
+  : std::bool_constant<std::is_trivially_copyable_v<T> && std::is_move_constructible_v<T>> {};
+
+template <class T>
+inline constexpr auto is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+namespace detail {
+/*! Trivially copyable types no bigger than a pointer, which dynamic_storage
+ *  keeps in the pointer itself !*/
+template <class T>
+inline constexpr bool is_pointer_sized_v =
+    sizeof(T) <= sizeof(void*) && alignof(void*) % alignof(T) == 0 &&
+    std::is_trivially_copyable_v<T> && std::is_copy_constructible_v<T>;
+
+/*! Lifecycle of an erased type, one constant table per type shared by all
+ *  the owning storages, so that an object handed over from one storage to
+ *  another one keeps its table, see handover. The size is 0 for empty
+ *  types, only that many bytes are relocated. Nothrow movable types are
+ *  either relocated or moved without throwing !*/
+struct move_ops {
+  std::size_t size;
+  std::size_t alignment;
+  bool movable;
+  bool nothrow_movable;
+  bool relocatable;
+  bool pointer_sized;
+  bool reusable;
+  void  (*destroy)(void*);
+  void  (*del)(void*);
+  void  (*move)(void*, void*);
+  void* (*move_new)(void*);
+  void  (*move_assign)(void*, void*);
+};
+
+/*! Move only storages don't give erased types the copy thunks !*/
+struct copy_ops : move_ops {
+  void  (*copy)(void*, const void*);
+  void* (*clone)(const void*);
+  void  (*copy_assign)(void*, const void*);
+};
+
+/*! With Adopted, the object was adopted through a std::unique_ptr<T> and
+ *  stays on the heap. T may then be a polymorphic base of the object,
+ *  which is neither moved, copied, assigned nor reused, see adopted_ops !*/
+template <class TOps, class T, bool Adopted = false>
+constexpr TOps make_ops() noexcept {
+  constexpr auto Exact = !Adopted || !std::is_polymorphic_v<T> || std::is_final_v<T>;
+  constexpr auto movable = Exact && std::is_move_constructible_v<T>;
+  constexpr auto copyable = Exact && std::is_copy_constructible_v<T>;
+  const move_ops ops{
+    std::is_empty_v<T> || !Exact ? 0 : sizeof(T),
+    alignof(T),
+    movable,
+    Exact && (std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>),
+    Exact && is_trivially_relocatable_v<T>,
+    !Adopted && is_pointer_sized_v<T>,
+    Exact && !has_class_allocation<T>::value,
+    [](void *self) {
+      static_cast<T *>(self)->~T();
+    },
+    [](void *self) {
+      delete static_cast<T *>(self);
+    },
+    [](void *self, void *other) {
+      if constexpr(movable)
+        new (self) T{std::move(*static_cast<T *>(other))};
+      else
+        throw std::runtime_error("te : erased type is not move constructible");
+    },
+    [](void *other) -> void * {
+      if constexpr(movable)
+        return new T{std::move(*static_cast<T *>(other))};
+      else
+        throw std::runtime_error("te : erased type is not move constructible");
+    },
+    Exact ? move_assign_of<T>() : nullptr
+  };
+  if constexpr (std::is_same_v<TOps, copy_ops>) {
+    return copy_ops{
+      ops,
+      [](void *self, const void *other) {
+        if constexpr(copyable)
+          new (self) T{*static_cast<const T *>(other)};
+        else
+          throw std::runtime_error("te : erased type is not copy constructible");
+      },
+      [](const void *other) -> void * {
+        if constexpr(copyable)
+          return new T{*static_cast<const T *>(other)};
+        else
+          throw std::runtime_error("te : erased type is not copy constructible");
+      },
+      Exact ? copy_assign_of<T>() : nullptr
+    };
+  } else {
+    return ops;
+  }
+}
+
+template <class TOps, class T, bool Adopted = false>
+inline constexpr TOps ops_v = make_ops<TOps, T, Adopted>();
+
+/*! Table of an object adopted through a std::unique_ptr<T>, which may point
+ *  to a type derived from a polymorphic T. Copying or moving it would slice
+ *  and its size is unknown, so it stays where it is. So do pointer sized
+ *  types, which would otherwise be moved out of their heap block !*/
+template <class TOps, class T>
+constexpr const TOps* adopted_ops() noexcept {
+  if constexpr ((std::is_polymorphic_v<T> && !std::is_final_v<T>) || is_pointer_sized_v<T>)
+    return &ops_v<TOps, T, true>;
+  else
+    return &ops_v<TOps, T>;
+}
+
+/*! Adopted pointers must not be null !*/
+template <class T>
+T* adopt(std::unique_ptr<T>& object) {
+  if (!object)
+    throw std::runtime_error("te : adopted pointer is null");
+  return object.release();
+}
+
+/*! The erased object of a storage on its way into another one. A heap
+ *  object which isn't copied may be adopted as it is, the target then
+ *  sets adopted and the source gives the object up with release() !*/
+template <class TOps>
+struct handover {
+  const TOps* ops;
+  void* object;
+  bool heap;
+  bool copy;
+  bool adopted;
+};
+
+/*! The handed over object on the heap, adopted when that's allowed !*/
+template <class TOps>
+void* heap_object(handover<TOps>& from) {
+  if (from.heap && !from.copy) {
+    from.adopted = true;
+    return from.object;
+  }
+  if constexpr (std::is_same_v<TOps, copy_ops>) {
+    if (from.copy)
+      return from.ops->clone(from.object);
+  }
+  return from.ops->move_new(from.object);
+}
+
+/*! The handed over object constructed at buffer !*/
+template <class TOps>
+void place_object(handover<TOps>& from, void* buffer) {
+  if constexpr (std::is_same_v<TOps, copy_ops>) {
+    if (from.copy) {
+      from.ops->copy(buffer, from.object);
+      return;
+    }
+  }
+  from.ops->move(buffer, from.object);
+}
+
+/*! Owns an object handed over to shared_storage. It's allocated before the
+ *  object is taken, so that a failed allocation leaves the object with its
+ *  source !*/
+struct shared_owner {
+  shared_owner() = default;
+  shared_owner(const shared_owner&) = delete;
+  shared_owner& operator=(const shared_owner&) = delete;
+
+  ~shared_owner()
+  {
+    if (ops)
+      ops->del(object);
+  }
+
+  const move_ops* ops = nullptr;
+  void* object = nullptr;
+};
 }  // namespace detail
 
 struct non_owning_storage
@@ -116,66 +392,145 @@ struct shared_storage
     std::enable_if_t<!std::is_same_v<T_,shared_storage>, bool> = true
   >
   constexpr explicit shared_storage(T &&t) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-  : ptr{std::make_shared<T_>(std::forward<T>(t))}
+  : shared_storage{std::in_place_type<T_>, std::forward<T>(t)}
   {
   }
 
+  template <class T, class... Ts>
+  explicit shared_storage(std::in_place_type_t<T>, Ts &&... args)
+  : ptr{make<T>(std::forward<Ts>(args)...)}
+  {
+  }
+
+  /*! Shares the ownership as-is, aliasing pointers included !*/
+  template <class T>
+  explicit shared_storage(std::shared_ptr<T> object) noexcept
+  : ptr{std::move(object)}
+  {
+  }
+
+  template <class T>
+  explicit shared_storage(std::unique_ptr<T> &&object)
+  : ptr{std::move(object)}
+  {
+  }
+
+  /*! Takes an object handed over by another storage, heap objects without
+   *  moving them !*/
+  template <class TOps>
+  explicit shared_storage(detail::handover<TOps>& from)
+  {
+    if (from.ops) {
+      auto owner = std::make_shared<detail::shared_owner>();
+      auto* object = detail::heap_object(from);
+      owner->ops = from.ops;
+      owner->object = object;
+      ptr = std::shared_ptr<void>{std::move(owner), object};
+    }
+  }
+
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args)
+  {
+    ptr = make<T>(std::forward<Ts>(args)...);
+    return *static_cast<T*>(ptr.get());
+  }
+
+  /*! Empty trivially copyable types have no state to share, they all point
+   *  to one static object, without a control block to allocate or count !*/
+  template <class T, class... Ts>
+  static std::shared_ptr<void> make(Ts &&... args)
+  {
+    if constexpr (std::is_empty_v<T> && std::is_trivially_copyable_v<T>) {
+      static detail::aligned_buffer<sizeof(T), alignof(T)> object{};
+      return std::shared_ptr<void>{std::shared_ptr<void>{},
+                                   new (&object) T{std::forward<Ts>(args)...}};
+    } else {
+      return std::make_shared<T>(std::forward<Ts>(args)...);
+    }
+  }
+
   std::shared_ptr<void> ptr;
 };
 
 struct dynamic_storage
 {
+  /*! Copyable, trivially copyable types no bigger than a pointer live in
+   *  the pointer itself, without an allocation !*/
+  template<typename T_>
+  struct type_fits : std::integral_constant<bool, detail::is_pointer_sized_v<T_>>{};
+
+  using mem_t = detail::aligned_buffer<sizeof(void*), alignof(void*)>;
+
+  /*! Lifecycle of the erased type, see detail::move_ops !*/
+  using ops_t = detail::copy_ops;
+
   template <
     class T,
     class T_ = std::decay_t<T>,
     std::enable_if_t<!std::is_same_v<T_,dynamic_storage>, bool> = true
   >
   constexpr explicit dynamic_storage(T &&t) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-  : ptr{new T_{std::forward<T>(t)}},
-    del{[](void *self) {
-      delete reinterpret_cast<T_ *>(self);
-    }},
-    copy{[](const void *other) -> void * {
-      if constexpr(std::is_copy_constructible_v<T_>)
-        return new T_{*reinterpret_cast<const T_*>(other)};
-      else
-        throw std::runtime_error("dynamic_storage : erased type is not copy constructible");
-    }}
+  : dynamic_storage{std::in_place_type<T_>, std::forward<T>(t)}
+  {
+  }
+
+  template <class T, class... Ts>
+  constexpr explicit dynamic_storage(std::in_place_type_t<T>, Ts &&... args)
+  {
+    emplace<T>(std::forward<Ts>(args)...);
+  }
+
+  /*! Takes the ownership over as-is, without allocating. Throws when the
+   *  pointer is null !*/
+  template <class T>
+  explicit dynamic_storage(std::unique_ptr<T> &&object)
+  : ptr{detail::adopt(object)},
+    ops{detail::adopted_ops<ops_t, T>()}
+  {
+  }
+
+  /*! Takes an object handed over by another storage, heap objects without
+   *  moving them !*/
+  explicit dynamic_storage(detail::handover<ops_t>& from)
   {
+    if (from.ops && from.ops->pointer_sized)
+      std::memcpy(&data, from.object, from.ops->size);
+    else if (from.ops)
+      ptr = detail::heap_object(from);
+    ops = from.ops;
   }
 
   constexpr dynamic_storage(const dynamic_storage& other)
-  : ptr{other.ptr ? other.copy(other.ptr) : nullptr},
-    del{other.del},
-    copy{other.copy}
   {
+    copy_from(other);
   }
 
   constexpr dynamic_storage& operator=(const dynamic_storage& other)
   {
-    if (other.ptr != ptr) {
+    if (&other != this) {
+      if (ops && ops == other.ops && ops->copy_assign) {
+        ops->copy_assign(get(), other.get());
+        return *this;
+      }
       reset();
-      ptr   = other.ptr ? other.copy(other.ptr) : nullptr;
-      del   = other.del;
-      copy  = other.copy;
+      copy_from(other);
     }
     return *this;
   }
 
   constexpr dynamic_storage(dynamic_storage&& other) noexcept
-  : ptr{detail::exchange(other.ptr, nullptr)},
-    del{detail::exchange(other.del, nullptr)},
-    copy{detail::exchange(other.copy, nullptr)}
+  : data{other.data},
+    ops{detail::exchange(other.ops, nullptr)}
   {
   }
 
   constexpr dynamic_storage& operator=(dynamic_storage&& other) noexcept
   {
-    if (other.ptr != ptr) {
+    if (&other != this) {
       reset();
-      ptr   = detail::exchange(other.ptr, nullptr);
-      del   = detail::exchange(other.del, nullptr);
-      copy  = detail::exchange(other.copy, nullptr);
+      data  = other.data;
+      ops   = detail::exchange(other.ops, nullptr);
     }
     return *this;
   }
@@ -187,20 +542,132 @@ struct dynamic_storage
 
   constexpr void reset() noexcept
   {
-    if (ptr)
-      del(ptr);
-    ptr = nullptr;
+    if (ops && !ops->pointer_sized)
+      ops->del(ptr);
+    ops = nullptr;
+  }
+
+  void* get() const noexcept
+  {
+    if (!ops)
+      return nullptr;
+    if (ops->pointer_sized)
+      return const_cast<mem_t*>(&data);
+    return ptr;
+  }
+
+  /*! Constructs T in the current heap block when it has the same size and
+   *  alignment, so that the same delete releases it later !*/
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args)
+  {
+    if constexpr (type_fits<T>::value) {
+      reset();
+      auto* object = new (&data) T{std::forward<Ts>(args)...};
+      ops = &detail::ops_v<ops_t, T>;
+      return *object;
+    } else {
+      if constexpr (std::is_nothrow_constructible_v<T, Ts&&...> &&
+                    !detail::has_class_allocation<T>::value) {
+        if (ops && !ops->pointer_sized && ops->reusable &&
+            ops->size == sizeof(T) && ops->alignment == alignof(T)) {
+          ops->destroy(ptr);
+          auto* object = new (ptr) T{std::forward<Ts>(args)...};
+          ops = &detail::ops_v<ops_t, T>;
+          return *object;
+        }
+      }
+      auto* object = new T{std::forward<Ts>(args)...};
+      reset();
+      ptr = object;
+      ops = &detail::ops_v<ops_t, T>;
+      return *object;
+    }
+  }
+
+  /*! Assigns to the erased object when it already is a T !*/
+  template <class T, class U>
+  T& assign(U &&value)
+  {
+    if constexpr (std::is_assignable_v<T&, U&&>) {
+      if (ops == &detail::ops_v<ops_t, T>) {
+        auto& object = *static_cast<T*>(get());
+        object = std::forward<U>(value);
+        return object;
+      }
+    }
+    return emplace<T>(std::forward<U>(value));
+  }
+
+  /*! The erased object on its way into another storage !*/
+  detail::handover<ops_t> hand_over(bool copy) const noexcept
+  {
+    return {ops, get(), ops && !ops->pointer_sized, copy, false};
+  }
+
+  /*! Gives up the ownership of the heap object, same as
+   *  std::unique_ptr::release(), null when there is none !*/
+  constexpr void* release() noexcept
+  {
+    if (!ops || ops->pointer_sized)
+      return nullptr;
+    ops = nullptr;
+    return ptr;
+  }
+
+  /*! The erased object when it is a T, inline ones are copied to the heap !*/
+  template <class T>
+  std::unique_ptr<T> into_unique()
+  {
+    if (ops != &detail::ops_v<ops_t, T> && ops != detail::adopted_ops<ops_t, T>())
+      return {};
+    if constexpr (type_fits<T>::value) {
+      if (ops->pointer_sized) {
+        auto object = std::make_unique<T>(*static_cast<T*>(get()));
+        reset();
+        return object;
+      }
+    }
+    return std::unique_ptr<T>{static_cast<T*>(release())};
+  }
+
+  constexpr void copy_from(const dynamic_storage& other)
+  {
+    if (other.ops && !other.ops->pointer_sized)
+      ptr = other.ops->clone(other.ptr);
+    else
+      data = other.data;
+    ops = other.ops;
   }
 
-  void* ptr                     = nullptr;
-  void  (*del)(void*)           = nullptr;
-  void* (*copy)(const void*)    = nullptr;
+  union {
+    void* ptr = nullptr;
+    mem_t data;
+  };
+  const ops_t* ops    = nullptr;
 };
 
-template <std::size_t Size, std::size_t Alignment = 8>
+/*! Moves may throw when the erased type's move does, types which can't
+ *  be moved at all don't fit. With NothrowMove, moves are noexcept instead
+ *  and erased types must be nothrow movable, see detail::move_ops, so that
+ *  containers grow by moving !*/
+template <std::size_t Size, std::size_t Alignment = 8, bool NothrowMove = false>
 struct local_storage
 {
-  using mem_t = std::aligned_storage_t<Size, Alignment>;
+  /*! Lifecycle of the erased type, see detail::move_ops !*/
+  using ops_t = detail::copy_ops;
+
+  /*! Whether an object handed over by another storage fits !*/
+  static constexpr bool fits(const detail::move_ops& ops) noexcept
+  {
+    return (NothrowMove ? ops.nothrow_movable : ops.movable) &&
+           ops.size <= Size && Alignment % ops.alignment == 0;
+  }
+
+  template<typename T_>
+  struct type_fits : std::integral_constant<bool, fits(detail::ops_v<ops_t, T_>)>{};
+
+  using mem_t = detail::aligned_buffer<Size, Alignment>;
 
   template <
     class T,
@@ -208,67 +675,83 @@ struct local_storage
     std::enable_if_t<!std::is_same_v<T_,local_storage>, bool> = true
   >
   constexpr explicit local_storage(T &&t) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-  : ptr{new (&data) T_{std::forward<T>(t)}},
-    del{[](mem_t& self) {
-      reinterpret_cast<T_ *>(&self)->~T_();
-    }},
-    copy{[](mem_t& self, const void* other) -> void* {
-      if constexpr(std::is_copy_constructible_v<T_>)
-        return new (&self) T_{*reinterpret_cast<const T_ *>(other)};
-      else
-        throw std::runtime_error("local_storage : erased type is not copy constructible");
-    }},
-    move{[](mem_t& self, void* other) -> void* {
-      if constexpr(std::is_move_constructible_v<T_>)
-        return new (&self) T_{std::move(*reinterpret_cast<T_ *>(other))};
-      else
-        throw std::runtime_error("local_storage : erased type is not move constructible");
-    }}
+  : local_storage{std::in_place_type<T_>, std::forward<T>(t)}
+  {
+  }
+
+  template <class T, class... Ts>
+  constexpr explicit local_storage(std::in_place_type_t<T>, Ts &&... args)
+      noexcept(std::is_nothrow_constructible_v<T,Ts&&...>)
+  {
+    emplace<T>(std::forward<Ts>(args)...);
+  }
+
+  /*! Takes an object handed over by another storage, which throws when it
+   *  doesn't fit !*/
+  explicit local_storage(detail::handover<ops_t>& from)
   {
-    static_assert(sizeof(T_) <= Size, "insufficient size");
-    static_assert(Alignment % alignof(T_) == 0, "bad alignment");
+    if (from.ops && !fits(*from.ops))
+      throw std::runtime_error("local_storage : erased type doesn't fit");
+    if (from.ops)
+      detail::place_object(from, &data);
+    ops = from.ops;
   }
 
   constexpr local_storage(const local_storage& other)
-  : ptr{other.ptr ? other.copy(data, other.ptr) : nullptr},
-    del{other.del},
-    copy{other.copy},
-    move{other.move}
   {
+    if (other.ops)
+      other.ops->copy(&data, &other.data);
+    ops = other.ops;
   }
 
   constexpr local_storage& operator=(const local_storage& other)
   {
-    if (other.ptr != ptr) {
+    if (&other != this) {
+      if (ops && ops == other.ops && ops->copy_assign) {
+        ops->copy_assign(&data, &other.data);
+        return *this;
+      }
       reset();
-      ptr   = other.ptr ? other.copy(data, other.ptr) : nullptr;
-      del   = other.del;
-      copy  = other.copy;
-      move  = other.move;
+      if (other.ops)
+        other.ops->copy(&data, &other.data);
+      ops = other.ops;
     }
     return *this;
   }
 
-  constexpr local_storage(local_storage&& other)
-  : ptr{other.ptr ? other.move(data, other.ptr) : nullptr},
-    del{other.del},
-    copy{other.copy},
-    move{other.move}
+  constexpr local_storage(local_storage&& other) noexcept(NothrowMove)
   {
+    move_from(other);
   }
 
-  constexpr local_storage& operator=(local_storage&& other)
+  constexpr local_storage& operator=(local_storage&& other) noexcept(NothrowMove)
   {
-    if (other.ptr != ptr) {
+    if (&other != this) {
+      if (ops && ops == other.ops && !ops->relocatable && ops->move_assign) {
+        ops->move_assign(&data, &other.data);
+        return *this;
+      }
       reset();
-      ptr   = other.ptr ? other.move(data, other.ptr) : nullptr;
-      del   = other.del;
-      copy  = other.copy;
-      move  = other.move;
+      move_from(other);
     }
     return *this;
   }
 
+  friend void swap(local_storage& lhs, local_storage& rhs) noexcept(NothrowMove)
+  {
+    if (lhs.relocatable() && rhs.relocatable()) {
+      mem_t tmp;
+      std::memcpy(&tmp, &lhs.data, lhs.size());
+      std::memcpy(&lhs.data, &rhs.data, rhs.size());
+      std::memcpy(&rhs.data, &tmp, lhs.size());
+      std::swap(lhs.ops, rhs.ops);
+    } else {
+      local_storage tmp{std::move(lhs)};
+      lhs = std::move(rhs);
+      rhs = std::move(tmp);
+    }
+  }
+
   ~local_storage()
   {
     reset();
@@ -276,115 +759,211 @@ struct local_storage
 
   constexpr void reset() noexcept
   {
-    if (ptr)
-      del(data);
-    ptr = nullptr;
+    if (ops)
+      ops->destroy(&data);
+    ops = nullptr;
+  }
+
+  /*! The old object is destroyed once the new one is constructed, so that
+   *  a throwing constructor leaves it as it was. Only a throwing move of
+   *  the constructed T into the buffer leaves the storage empty !*/
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args) noexcept(std::is_nothrow_constructible_v<T,Ts&&...>)
+  {
+    static_assert(sizeof(T) <= Size, "insufficient size");
+    static_assert(Alignment % alignof(T) == 0, "bad alignment");
+    static_assert(std::is_move_constructible_v<T>, "type must be move constructible");
+    static_assert(!NothrowMove || detail::ops_v<ops_t, T>.nothrow_movable,
+                  "type must be nothrow move constructible or trivially relocatable");
+    if constexpr (!std::is_nothrow_constructible_v<T, Ts&&...>) {
+      if (ops) {
+        T tmp{std::forward<Ts>(args)...};
+        reset();
+        auto* object = new (&data) T{std::move(tmp)};
+        ops = &detail::ops_v<ops_t, T>;
+        return *object;
+      }
+    }
+    reset();
+    auto* object = new (&data) T{std::forward<Ts>(args)...};
+    ops = &detail::ops_v<ops_t, T>;
+    return *object;
+  }
+
+  /*! Assigns to the erased object when it already is a T !*/
+  template <class T, class U>
+  T& assign(U &&value)
+  {
+    if constexpr (std::is_assignable_v<T&, U&&>) {
+      if (ops == &detail::ops_v<ops_t, T>) {
+        auto& object = *reinterpret_cast<T*>(&data);
+        object = std::forward<U>(value);
+        return object;
+      }
+    }
+    return emplace<T>(std::forward<U>(value));
+  }
+
+  void* get() const noexcept
+  {
+    return ops ? const_cast<mem_t*>(&data) : nullptr;
+  }
+
+  /*! The erased object on its way into another storage !*/
+  detail::handover<ops_t> hand_over(bool copy) const noexcept
+  {
+    return {ops, get(), false, copy, false};
+  }
+
+  /*! Objects are never on the heap, there is nothing to give up !*/
+  constexpr void* release() noexcept
+  {
+    return nullptr;
+  }
+
+  constexpr bool relocatable() const noexcept
+  {
+    return !ops || ops->relocatable;
+  }
+
+  /*! Bytes taken by the erased object, only those are relocated (none
+   *  for empty types) !*/
+  constexpr std::size_t size() const noexcept
+  {
+    return ops ? ops->size : 0;
+  }
+
+  constexpr void move_from(local_storage& other) noexcept(NothrowMove)
+  {
+    if (other.relocatable()) {
+      std::memcpy(&data, &other.data, other.size());
+      ops = detail::exchange(other.ops, nullptr);
+    } else {
+      other.ops->move(&data, &other.data);
+      ops = other.ops;
+    }
   }
 
   mem_t data;
-  void* ptr                               = nullptr;
-  void  (*del)(mem_t&)                    = nullptr;
-  void* (*copy)(mem_t& mem, const void*)  = nullptr;
-  void* (*move)(mem_t& mem, void*)        = nullptr;
+  const ops_t* ops = nullptr;
 };
 
-template <std::size_t Size, std::size_t Alignment = 8>
+/*! With Copyable = false the storage is move only, see unique_sbo_storage !*/
+template <std::size_t Size, std::size_t Alignment = 8, bool Copyable = true>
 struct sbo_storage
 {
+  /*! Lifecycle of the erased type, see detail::move_ops. Move only
+   *  storages don't give erased types a copy thunk !*/
+  using ops_t = std::conditional_t<Copyable, detail::copy_ops, detail::move_ops>;
+
+  /*! Moves are noexcept. Types which can't be moved without throwing are
+   *  kept on the heap, where moving the storage moves the pointer. Taken
+   *  from the table, so that objects handed over by other storages are
+   *  placed the same way !*/
+  static constexpr bool fits(const detail::move_ops& ops) noexcept
+  {
+    return ops.nothrow_movable && ops.size <= Size && Alignment % ops.alignment == 0;
+  }
+
   template<typename T_>
-  struct type_fits : std::integral_constant<bool, sizeof(T_) <= Size && Alignment % alignof(T_) == 0>{};
+  struct type_fits : std::integral_constant<bool, fits(detail::ops_v<ops_t, T_>)>{};
 
-  using mem_t = std::aligned_storage_t<Size, Alignment>;
+  /*! Big enough to hold the heap pointer when the type doesn't fit !*/
+  using mem_t = detail::aligned_buffer<
+    (Size > sizeof(void*) ? Size : sizeof(void*)),
+    (Alignment > alignof(void*) ? Alignment : alignof(void*))
+  >;
 
   template <
     class T,
     class T_ = std::decay_t<T>,
-    std::enable_if_t<!std::is_same_v<T_,sbo_storage>, bool> = true,
-    std::enable_if_t<type_fits<T_>::value, bool> = true
+    std::enable_if_t<!std::is_same_v<T_,sbo_storage>, bool> = true
   >
   constexpr explicit sbo_storage(T &&t) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-  : ptr{new (&data) T_{std::forward<T>(t)}},
-    del{[](mem_t& self_mem, void*) {
-      reinterpret_cast<T_ *>(&self_mem)->~T_();
-    }},
-    copy{[](mem_t& self_mem, const void* other) -> void* {
-      if constexpr(std::is_copy_constructible_v<T_>)
-        return new (&self_mem) T_{*reinterpret_cast<const T_ *>(other)};
-      else
-        throw std::runtime_error("sbo_storage : erased type is not copy constructible");
-    }},
-    move{[](mem_t& self_mem, void*& other) -> void* {
-      if constexpr(std::is_move_constructible_v<T_>)
-        return new (&self_mem) T_{std::move(*reinterpret_cast<T_ *>(other))};
-      else
-        throw std::runtime_error("sbo_storage : erased type is not move constructible");
-    }}
+  : sbo_storage{std::in_place_type<T_>, std::forward<T>(t)}
   {
   }
 
-  template <
-    class T,
-    class T_ = std::decay_t<T>,
-    std::enable_if_t<!std::is_same_v<T_,sbo_storage>, bool> = true,
-    std::enable_if_t<!type_fits<T_>::value, bool> = true
-  >
-  constexpr explicit sbo_storage(T &&t) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-  : ptr{new T_{std::forward<T>(t)}},
-    del{[](mem_t&, void* self_ptr) {
-      delete reinterpret_cast<T_ *>(self_ptr);
-    }},
-    copy{[](mem_t&, const void* other) -> void* {
-      if constexpr(std::is_copy_constructible_v<T_>)
-        return new T_{*reinterpret_cast<const T_*>(other)};
-      else
-        throw std::runtime_error("dynamic_storage : erased type is not copy constructible");
-    }},
-    move{[](mem_t&, void*& other) {
-      return detail::exchange(other, nullptr);
-    }}
+  template <class T, class... Ts>
+  constexpr explicit sbo_storage(std::in_place_type_t<T>, Ts &&... args)
+      noexcept(std::is_nothrow_constructible_v<T,Ts&&...>)
   {
+    emplace<T>(std::forward<Ts>(args)...);
   }
 
-  constexpr sbo_storage(const sbo_storage& other)
-    : ptr{other.ptr ? other.copy(data, other.ptr) : nullptr},
-      del{other.del},
-      copy{other.copy},
-      move{other.move}
+  /*! Takes an object handed over by another storage, heap objects which
+   *  don't fit without moving them !*/
+  template <class TOps>
+  explicit sbo_storage(detail::handover<TOps>& from)
   {
+    if (!from.ops)
+      return;
+    if (fits(*from.ops))
+      detail::place_object(from, &data);
+    else
+      *reinterpret_cast<void **>(&data) = detail::heap_object(from);
+    ops = from.ops;
   }
 
-  constexpr sbo_storage& operator=(const sbo_storage& other)
+  /*! Not a copy constructor when the storage is move only, the implicit
+   *  one is then deleted by the move constructor below !*/
+  using copy_t = std::conditional_t<Copyable, sbo_storage, detail::move_only<sbo_storage>>;
+
+  constexpr sbo_storage(const copy_t& other)
   {
-    if (other.ptr != ptr) {
+    if (other.ops)
+      copy_from(other);
+    ops = other.ops;
+  }
+
+  constexpr sbo_storage& operator=(const copy_t& other)
+  {
+    if (&other != this) {
+      if (ops && ops == other.ops && ops->copy_assign) {
+        ops->copy_assign(get(), other.get());
+        return *this;
+      }
       reset();
-      ptr   = other.ptr ? other.copy(data, other.ptr) : nullptr;
-      del   = other.del;
-      copy  = other.copy;
-      move  = other.move;
+      if (other.ops)
+        copy_from(other);
+      ops = other.ops;
     }
     return *this;
   }
 
-  constexpr sbo_storage(sbo_storage&& other)
-    : ptr{other.ptr ? other.move(data, other.ptr) : nullptr},
-      del{other.del},
-      copy{other.copy},
-      move{other.move}
+  constexpr sbo_storage(sbo_storage&& other) noexcept
   {
+    move_from(other);
   }
 
-  constexpr sbo_storage& operator=(sbo_storage&& other)
+  constexpr sbo_storage& operator=(sbo_storage&& other) noexcept
   {
-    if (other.ptr != ptr) {
+    if (&other != this) {
+      if (ops && ops == other.ops && !relocatable() && ops->move_assign) {
+        ops->move_assign(&data, &other.data);
+        return *this;
+      }
       reset();
-      ptr   = other.ptr ? other.move(data, other.ptr) : nullptr;
-      del   = other.del;
-      copy  = other.copy;
-      move  = other.move;
+      move_from(other);
     }
     return *this;
   }
 
+  friend void swap(sbo_storage& lhs, sbo_storage& rhs) noexcept
+  {
+    if (lhs.relocatable() && rhs.relocatable()) {
+      mem_t tmp;
+      std::memcpy(&tmp, &lhs.data, lhs.size());
+      std::memcpy(&lhs.data, &rhs.data, rhs.size());
+      std::memcpy(&rhs.data, &tmp, lhs.size());
+      std::swap(lhs.ops, rhs.ops);
+    } else {
+      sbo_storage tmp{std::move(lhs)};
+      lhs = std::move(rhs);
+      rhs = std::move(tmp);
+    }
+  }
+
   ~sbo_storage()
   {
     reset();
@@ -392,113 +971,1996 @@ struct sbo_storage
 
   constexpr void reset() noexcept
   {
-    if (ptr)
-      del(data, ptr);
-    ptr = nullptr;
+    if (ops && local())
+      ops->destroy(&data);
+    else if (ops)
+      ops->del(*reinterpret_cast<void **>(&data));
+    ops = nullptr;
   }
 
-  mem_t data;
-  void* ptr                           = nullptr;
-  void  (*del)(mem_t&, void*)         = nullptr;
-  void* (*copy)(mem_t&, const void*)  = nullptr;
-  void* (*move)(mem_t&, void*&)       = nullptr;
-};
+  /*! The old object is destroyed once the new one is constructed, so that
+   *  a throwing constructor leaves it as it was !*/
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args) noexcept(std::is_nothrow_constructible_v<T,Ts&&...>)
+  {
+    if constexpr (type_fits<T>::value) {
+      if constexpr (!std::is_nothrow_constructible_v<T, Ts&&...>) {
+        if (ops) {
+          T tmp{std::forward<Ts>(args)...};
+          reset();
+          auto* object = new (&data) T{std::move(tmp)};
+          ops = &detail::ops_v<ops_t, T>;
+          return *object;
+        }
+      }
+      reset();
+      auto* object = new (&data) T{std::forward<Ts>(args)...};
+      ops = &detail::ops_v<ops_t, T>;
+      return *object;
+    } else {
+      auto* object = new T{std::forward<Ts>(args)...};
+      reset();
+      *reinterpret_cast<T **>(&data) = object;
+      ops = &detail::ops_v<ops_t, T>;
+      return *object;
+    }
+  }
 
-class static_vtable {
-  using ptr_t = void *;
+  /*! Assigns to the erased object when it already is a T !*/
+  template <class T, class U>
+  T& assign(U &&value)
+  {
+    if constexpr (std::is_assignable_v<T&, U&&>) {
+      if (ops == &detail::ops_v<ops_t, T>) {
+        auto& object = *static_cast<T*>(get());
+        object = std::forward<U>(value);
+        return object;
+      }
+    }
+    return emplace<T>(std::forward<U>(value));
+  }
 
- public:
-  template <class T, std::size_t Size>
-  explicit static_vtable(T &&, ptr_t *&vtable,
-                std::integral_constant<std::size_t, Size>) noexcept {
-    static ptr_t vt[Size]{};
-    vtable = vt;
+  void* get() const noexcept
+  {
+    if (!ops)
+      return nullptr;
+    if (local())
+      return const_cast<mem_t*>(&data);
+    return *reinterpret_cast<void* const*>(&data);
   }
-};
 
-namespace detail {
-struct poly_base {
-  void** vptr = nullptr;
-  virtual void* ptr() const noexcept = 0;
-};
-}  // namespace detail
+  /*! Whether the erased object is in the buffer rather than on the heap !*/
+  constexpr bool local() const noexcept
+  {
+    return fits(*ops);
+  }
 
-template <
-  class I,
-  class TStorage = dynamic_storage,
-  class TVtable = static_vtable
->
-class poly : detail::poly_base,
-             public std::conditional_t<detail::is_complete<I>{}, I,
-                                       detail::type_list<I> > {
- public:
-  template <
-    class T,
-    class T_ = std::decay_t<T>,
-    std::enable_if_t<!std::is_same_v<T_, poly>, bool> = true
-  >
-  constexpr poly(T &&t) // cppcheck-suppress noExplicitConstructor
-      noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-      : poly{std::forward<T>(t),
-             detail::type_list<decltype(detail::requires__<I>(bool{}))>{}} {}
-
-  constexpr poly(poly const &)
-      noexcept(std::is_nothrow_copy_constructible_v<TStorage>) = default;
-  constexpr poly &operator=(poly const &)
-      noexcept(std::is_nothrow_copy_constructible_v<TStorage>) = default;
-  constexpr poly(poly &&)
-      noexcept(std::is_nothrow_move_constructible_v<TStorage>) = default;
-  constexpr poly &operator=(poly &&)
-      noexcept(std::is_nothrow_move_constructible_v<TStorage>) = default;
+  /*! Heap objects are relocated by relocating the pointer !*/
+  constexpr bool relocatable() const noexcept
+  {
+    return !ops || !local() || ops->relocatable;
+  }
 
- private:
+  /*! Bytes taken by the erased object or the heap pointer, only those are
+   *  relocated !*/
+  constexpr std::size_t size() const noexcept
+  {
+    if (!ops)
+      return 0;
+    return local() ? ops->size : sizeof(void*);
+  }
 
-  template <
+  /*! The erased object on its way into another storage !*/
+  detail::handover<ops_t> hand_over(bool copy) const noexcept
+  {
+    return {ops, get(), ops && !local(), copy, false};
+  }
+
+  /*! Gives up the ownership of the heap object, same as
+   *  dynamic_storage::release(), null when there is none !*/
+  constexpr void* release() noexcept
+  {
+    if (!ops || local())
+      return nullptr;
+    ops = nullptr;
+    return *reinterpret_cast<void **>(&data);
+  }
+
+  constexpr void copy_from(const sbo_storage& other)
+  {
+    if (other.local())
+      other.ops->copy(&data, &other.data);
+    else
+      *reinterpret_cast<void **>(&data) = other.ops->clone(other.get());
+  }
+
+  constexpr void move_from(sbo_storage& other) noexcept
+  {
+    if (other.relocatable()) {
+      std::memcpy(&data, &other.data, other.size());
+      ops = detail::exchange(other.ops, nullptr);
+    } else {
+      other.ops->move(&data, &other.data);
+      ops = other.ops;
+    }
+  }
+
+  mem_t data;
+  const ops_t* ops = nullptr;
+};
+
+/*! Big enough for each of Ts, which are all stored inline !*/
+template <class... Ts>
+using sbo_storage_for = sbo_storage<detail::max_of(sizeof(Ts)...), detail::max_of(alignof(Ts)...)>;
+
+/*! Same as sbo_storage_for, but storing a type which doesn't fit is a
+ *  compile error instead of a heap allocation !*/
+template <class... Ts>
+using local_storage_for = local_storage<detail::max_of(sizeof(Ts)...), detail::max_of(alignof(Ts)...)>;
+
+/*! Aligns the poly to a cache line and fills the rest of it with the
+ *  buffer, so that polys in per thread arrays don't share a line !*/
+struct cacheline_storage : sbo_storage<64 - 3 * sizeof(void*)>
+{
+  static constexpr std::size_t poly_alignment = 64;
+
+  using sbo_storage<64 - 3 * sizeof(void*)>::sbo_storage;
+};
+
+/*! Same as dynamic_storage but move only, so that erased types don't get a
+ *  copy thunk, nor a copy slot in their table !*/
+struct unique_storage
+{
+  /*! Lifecycle of the erased type, see detail::move_ops !*/
+  using ops_t = detail::move_ops;
+
+  template <
+    class T,
+    class T_ = std::decay_t<T>,
+    std::enable_if_t<!std::is_same_v<T_,unique_storage>, bool> = true
+  >
+  constexpr explicit unique_storage(T &&t) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
+  : unique_storage{std::in_place_type<T_>, std::forward<T>(t)}
+  {
+  }
+
+  template <class T, class... Ts>
+  constexpr explicit unique_storage(std::in_place_type_t<T>, Ts &&... args)
+  : ptr{new T{std::forward<Ts>(args)...}},
+    ops{&detail::ops_v<ops_t, T>}
+  {
+  }
+
+  /*! Takes the ownership over as-is, without allocating. Throws when the
+   *  pointer is null !*/
+  template <class T>
+  explicit unique_storage(std::unique_ptr<T> &&object)
+  : ptr{detail::adopt(object)},
+    ops{detail::adopted_ops<ops_t, T>()}
+  {
+  }
+
+  /*! Takes an object handed over by another storage, heap objects without
+   *  moving them !*/
+  template <class TOps>
+  explicit unique_storage(detail::handover<TOps>& from)
+  {
+    if (from.ops) {
+      ptr = detail::heap_object(from);
+      ops = from.ops;
+    }
+  }
+
+  unique_storage(const unique_storage&) = delete;
+  unique_storage& operator=(const unique_storage&) = delete;
+
+  constexpr unique_storage(unique_storage&& other) noexcept
+  : ptr{detail::exchange(other.ptr, nullptr)},
+    ops{detail::exchange(other.ops, nullptr)}
+  {
+  }
+
+  constexpr unique_storage& operator=(unique_storage&& other) noexcept
+  {
+    if (other.ptr != ptr) {
+      reset();
+      ptr   = detail::exchange(other.ptr, nullptr);
+      ops   = detail::exchange(other.ops, nullptr);
+    }
+    return *this;
+  }
+
+  ~unique_storage()
+  {
+    reset();
+  }
+
+  constexpr void reset() noexcept
+  {
+    if (ptr)
+      ops->del(ptr);
+    ptr = nullptr;
+  }
+
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args)
+  {
+    auto* object = new T{std::forward<Ts>(args)...};
+    reset();
+    ptr = object;
+    ops = &detail::ops_v<ops_t, T>;
+    return *object;
+  }
+
+  /*! Assigns to the erased object when it already is a T !*/
+  template <class T, class U>
+  T& assign(U &&value)
+  {
+    if constexpr (std::is_assignable_v<T&, U&&>) {
+      if (ptr && ops == &detail::ops_v<ops_t, T>) {
+        auto& object = *static_cast<T*>(ptr);
+        object = std::forward<U>(value);
+        return object;
+      }
+    }
+    return emplace<T>(std::forward<U>(value));
+  }
+
+  /*! The erased object on its way into another storage !*/
+  constexpr detail::handover<ops_t> hand_over(bool copy) const noexcept
+  {
+    return {ptr ? ops : nullptr, ptr, true, copy, false};
+  }
+
+  /*! Gives up the ownership of the object, same as
+   *  std::unique_ptr::release() !*/
+  constexpr void* release() noexcept
+  {
+    return detail::exchange(ptr, nullptr);
+  }
+
+  void* ptr           = nullptr;
+  const ops_t* ops    = nullptr;
+};
+
+/*! Same as sbo_storage but move only, see unique_storage !*/
+template <std::size_t Size, std::size_t Alignment = 8>
+using unique_sbo_storage = sbo_storage<Size, Alignment, false>;
+
+template <class Alloc = std::allocator<std::byte>>
+struct allocator_storage
+{
+  using allocator_type = Alloc;
+
+  /*! Lifecycle of the erased type, one constant table per type !*/
+  struct ops_t {
+    void  (*del)(void*, const Alloc&);
+    void* (*copy)(const void*, const Alloc&);
+  };
+
+  template <class T_, class... Ts>
+  static T_* allocate(const Alloc& alloc, Ts&&... args)
+  {
+    using alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<T_>;
+    using traits_t = std::allocator_traits<alloc_t>;
+    alloc_t a{alloc};
+    auto ptr = traits_t::allocate(a, 1);
+    try {
+      traits_t::construct(a, ptr, std::forward<Ts>(args)...);
+    } catch (...) {
+      traits_t::deallocate(a, ptr, 1);
+      throw;
+    }
+    return ptr;
+  }
+
+  template <class T_>
+  static constexpr ops_t ops_v{
+    [](void *self, const Alloc& alloc) {
+      using alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<T_>;
+      using traits_t = std::allocator_traits<alloc_t>;
+      alloc_t a{alloc};
+      traits_t::destroy(a, reinterpret_cast<T_ *>(self));
+      traits_t::deallocate(a, reinterpret_cast<T_ *>(self), 1);
+    },
+    [](const void *other, const Alloc& alloc) -> void * {
+      if constexpr(std::is_copy_constructible_v<T_>)
+        return allocate<T_>(alloc, *reinterpret_cast<const T_*>(other));
+      else
+        throw std::runtime_error("allocator_storage : erased type is not copy constructible");
+    }
+  };
+
+  template <
+    class T,
+    class T_ = std::decay_t<T>,
+    std::enable_if_t<!std::is_same_v<T_,allocator_storage>, bool> = true
+  >
+  constexpr explicit allocator_storage(T &&t)
+  : allocator_storage{std::allocator_arg, Alloc{}, std::forward<T>(t)}
+  {
+  }
+
+  template <
+    class T,
+    class T_ = std::decay_t<T>,
+    std::enable_if_t<!std::is_same_v<T_,allocator_storage>, bool> = true
+  >
+  constexpr allocator_storage(std::allocator_arg_t, const Alloc& alloc, T &&t)
+  : allocator_storage{std::allocator_arg, alloc, std::in_place_type<T_>, std::forward<T>(t)}
+  {
+  }
+
+  template <class T, class... Ts>
+  constexpr explicit allocator_storage(std::in_place_type_t<T> type, Ts &&... args)
+  : allocator_storage{std::allocator_arg, Alloc{}, type, std::forward<Ts>(args)...}
+  {
+  }
+
+  template <class T, class... Ts>
+  constexpr allocator_storage(std::allocator_arg_t, const Alloc& alloc, std::in_place_type_t<T>, Ts &&... args)
+  : ptr{allocate<T>(alloc, std::forward<Ts>(args)...)},
+    ops{&ops_v<T>},
+    alloc{alloc}
+  {
+  }
+
+  /*! Copies are allocated by the allocator of the object they are copied from !*/
+  constexpr allocator_storage(const allocator_storage& other)
+  : ptr{other.ptr ? other.ops->copy(other.ptr, other.alloc) : nullptr},
+    ops{other.ops},
+    alloc{other.alloc}
+  {
+  }
+
+  constexpr allocator_storage& operator=(const allocator_storage& other)
+  {
+    if (other.ptr != ptr) {
+      reset();
+      ptr   = other.ptr ? other.ops->copy(other.ptr, other.alloc) : nullptr;
+      ops   = other.ops;
+      rebind(other.alloc);
+    }
+    return *this;
+  }
+
+  constexpr allocator_storage(allocator_storage&& other) noexcept
+  : ptr{detail::exchange(other.ptr, nullptr)},
+    ops{detail::exchange(other.ops, nullptr)},
+    alloc{other.alloc}
+  {
+  }
+
+  constexpr allocator_storage& operator=(allocator_storage&& other) noexcept
+  {
+    if (other.ptr != ptr) {
+      reset();
+      ptr   = detail::exchange(other.ptr, nullptr);
+      ops   = detail::exchange(other.ops, nullptr);
+      rebind(other.alloc);
+    }
+    return *this;
+  }
+
+  ~allocator_storage()
+  {
+    reset();
+  }
+
+  constexpr void reset() noexcept
+  {
+    if (ptr)
+      ops->del(ptr, alloc);
+    ptr = nullptr;
+  }
+
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args)
+  {
+    auto* object = allocate<T>(alloc, std::forward<Ts>(args)...);
+    reset();
+    ptr = object;
+    ops = &ops_v<T>;
+    return *object;
+  }
+
+  constexpr allocator_type get_allocator() const noexcept
+  {
+    return alloc;
+  }
+
+  /*! The object and the allocator it came from always travel together,
+   *  also for allocators which are not assignable (std::pmr) !*/
+  void rebind(const Alloc& other) noexcept
+  {
+    alloc.~Alloc();
+    new (&alloc) Alloc{other};
+  }
+
+  void* ptr           = nullptr;
+  const ops_t* ops    = nullptr;
+  Alloc alloc{};
+};
+
+#if defined(__cpp_lib_memory_resource)
+using pmr_storage = allocator_storage<std::pmr::polymorphic_allocator<std::byte>>;
+#endif
+
+/*! Per thread counters of the pooled_storage allocator !*/
+struct pool_stats {
+  std::size_t allocations{};
+  std::size_t reuses{};
+  std::size_t deallocations{};
+  std::size_t remote_deallocations{};
+};
+
+namespace detail {
+/*! Thread local free lists of size classes. Blocks freed by another thread
+ *  are handed back to the owner through a lock-free list, the owner picks
+ *  them up on its next allocation. The pool of a finished thread gives its
+ *  cached blocks back and is freed with the last of its blocks still in
+ *  use, blocks allocated after that (by thread_local destructors) come
+ *  from ::operator new !*/
+class pool final {
+  struct alignas(std::max_align_t) header {
+    pool* owner;
+    std::size_t size_class;
+  };
+
+  struct node {
+    node* next;
+    std::size_t size_class;
+  };
+
+  struct free_list {
+    node* head{};
+    std::size_t size{};
+  };
+
+  struct handle {
+    pool* ptr;
+    handle() : ptr{new pool{}} { current() = ptr; }
+    ~handle() noexcept {
+      current() = nullptr;
+      finished() = true;
+      ptr->abandon();
+    }
+  };
+
+  /*! Blocks in use are counted by the owner, remote frees are taken off
+   *  this bias so that only the abandoned pool can reach zero !*/
+  static constexpr std::ptrdiff_t bias = PTRDIFF_MAX / 2;
+
+ public:
+  static constexpr std::size_t size_classes[] = {16, 32, 64, 128, 256};
+  static constexpr std::size_t npos = sizeof(size_classes) / sizeof(size_classes[0]);
+  static constexpr std::size_t max_cached = 1024;
+
+  static constexpr std::size_t size_class(std::size_t size, std::size_t alignment) noexcept {
+    if (alignment > alignof(header))
+      return npos;
+    for (std::size_t i{}; i < npos; ++i)
+      if (size <= size_classes[i])
+        return i;
+    return npos;
+  }
+
+  /*! The calling thread's pool, null once it's finished !*/
+  static pool* local() {
+    if (auto* ptr = current())
+      return ptr;
+    if (finished())
+      return nullptr;
+    thread_local const handle h{};
+    return h.ptr;
+  }
+
+  static void* allocate(std::size_t size_class) {
+    if (auto* owner = local())
+      return owner->take(size_class);
+    auto* block = ::operator new(sizeof(header) + size_classes[size_class]);
+    return new (block) header{nullptr, size_class} + 1;
+  }
+
+  static void deallocate(void* ptr) noexcept {
+    auto* block = static_cast<header*>(ptr) - 1;
+    auto* owner = block->owner;
+    if (!owner) {
+      ::operator delete(block);
+      return;
+    }
+    auto* n = new (block) node{nullptr, block->size_class};
+    if (owner == current()) {
+      ++owner->stats_.deallocations;
+      --owner->live_;
+      owner->cache(n);
+    } else {
+      n->next = owner->remote_.load(std::memory_order_relaxed);
+      while (!owner->remote_.compare_exchange_weak(n->next, n, std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+      }
+      if (owner->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete owner;
+    }
+  }
+
+  /*! Counters of the calling thread's pool, zero once it's finished !*/
+  static const pool_stats& stats() {
+    static constexpr pool_stats none{};
+    auto* owner = local();
+    return owner ? owner->stats_ : none;
+  }
+
+  ~pool() {
+    for (auto* n = remote_.exchange(nullptr, std::memory_order_acquire); n;)
+      ::operator delete(detail::exchange(n, n->next));
+    for (auto& list : free_)
+      for (auto* n = list.head; n;)
+        ::operator delete(detail::exchange(n, n->next));
+  }
+
+ private:
+  static pool*& current() noexcept {
+    thread_local pool* ptr = nullptr;
+    return ptr;
+  }
+
+  static bool& finished() noexcept {
+    thread_local bool value = false;
+    return value;
+  }
+
+  void* take(std::size_t size_class) {
+    if (remote_.load(std::memory_order_relaxed))
+      collect();
+    void* block = nullptr;
+    if (auto& list = free_[size_class]; list.head) {
+      block = detail::exchange(list.head, list.head->next);
+      --list.size;
+      ++stats_.reuses;
+    } else {
+      block = ::operator new(sizeof(header) + size_classes[size_class]);
+    }
+    ++stats_.allocations;
+    ++live_;
+    return new (block) header{this, size_class} + 1;
+  }
+
+  /*! Called by the owner when its thread finishes, the pool then lives
+   *  only as long as its blocks still in use !*/
+  void abandon() noexcept {
+    collect();
+    for (auto& list : free_) {
+      for (auto* n = list.head; n;)
+        ::operator delete(detail::exchange(n, n->next));
+      list = {};
+    }
+    const auto in_use = live_ - bias;
+    if (pending_.fetch_add(in_use, std::memory_order_acq_rel) + in_use == 0)
+      delete this;
+  }
+
+  void cache(node* n) noexcept {
+    if (auto& list = free_[n->size_class]; list.size < max_cached) {
+      n->next = list.head;
+      list.head = n;
+      ++list.size;
+    } else {
+      ::operator delete(n);
+    }
+  }
+
+  void collect() noexcept {
+    for (auto* n = remote_.exchange(nullptr, std::memory_order_acquire); n;) {
+      ++stats_.remote_deallocations;
+      cache(detail::exchange(n, n->next));
+    }
+  }
+
+  free_list free_[npos]{};
+  pool_stats stats_{};
+  std::ptrdiff_t live_{};
+  std::atomic<std::ptrdiff_t> pending_{bias};
+  std::atomic<node*> remote_{nullptr};
+};
+}  // namespace detail
+
+struct pooled_storage
+{
+  /*! Lifecycle of the erased type, one constant table per type !*/
+  struct ops_t {
+    void  (*del)(void*);
+    void* (*copy)(const void*);
+  };
+
+  template <class T_>
+  static constexpr auto size_class = detail::pool::size_class(sizeof(T_), alignof(T_));
+
+  template <class T_, class... Ts>
+  static T_* allocate(Ts&&... args)
+  {
+    if constexpr(size_class<T_> != detail::pool::npos) {
+      auto* mem = detail::pool::allocate(size_class<T_>);
+      try {
+        return new (mem) T_{std::forward<Ts>(args)...};
+      } catch (...) {
+        detail::pool::deallocate(mem);
+        throw;
+      }
+    } else {
+      return new T_{std::forward<Ts>(args)...};
+    }
+  }
+
+  template <class T_>
+  static constexpr ops_t ops_v{
+    [](void *self) {
+      if constexpr(size_class<T_> != detail::pool::npos) {
+        reinterpret_cast<T_ *>(self)->~T_();
+        detail::pool::deallocate(self);
+      } else {
+        delete reinterpret_cast<T_ *>(self);
+      }
+    },
+    [](const void *other) -> void * {
+      if constexpr(std::is_copy_constructible_v<T_>)
+        return allocate<T_>(*reinterpret_cast<const T_*>(other));
+      else
+        throw std::runtime_error("pooled_storage : erased type is not copy constructible");
+    }
+  };
+
+  template <
+    class T,
+    class T_ = std::decay_t<T>,
+    std::enable_if_t<!std::is_same_v<T_,pooled_storage>, bool> = true
+  >
+  constexpr explicit pooled_storage(T &&t)
+  : pooled_storage{std::in_place_type<T_>, std::forward<T>(t)}
+  {
+  }
+
+  template <class T, class... Ts>
+  constexpr explicit pooled_storage(std::in_place_type_t<T>, Ts &&... args)
+  : ptr{allocate<T>(std::forward<Ts>(args)...)},
+    ops{&ops_v<T>}
+  {
+  }
+
+  constexpr pooled_storage(const pooled_storage& other)
+  : ptr{other.ptr ? other.ops->copy(other.ptr) : nullptr},
+    ops{other.ops}
+  {
+  }
+
+  constexpr pooled_storage& operator=(const pooled_storage& other)
+  {
+    if (other.ptr != ptr) {
+      reset();
+      ptr   = other.ptr ? other.ops->copy(other.ptr) : nullptr;
+      ops   = other.ops;
+    }
+    return *this;
+  }
+
+  constexpr pooled_storage(pooled_storage&& other) noexcept
+  : ptr{detail::exchange(other.ptr, nullptr)},
+    ops{detail::exchange(other.ops, nullptr)}
+  {
+  }
+
+  constexpr pooled_storage& operator=(pooled_storage&& other) noexcept
+  {
+    if (other.ptr != ptr) {
+      reset();
+      ptr   = detail::exchange(other.ptr, nullptr);
+      ops   = detail::exchange(other.ops, nullptr);
+    }
+    return *this;
+  }
+
+  ~pooled_storage()
+  {
+    reset();
+  }
+
+  constexpr void reset() noexcept
+  {
+    if (ptr)
+      ops->del(ptr);
+    ptr = nullptr;
+  }
+
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args)
+  {
+    auto* object = allocate<T>(std::forward<Ts>(args)...);
+    reset();
+    ptr = object;
+    ops = &ops_v<T>;
+    return *object;
+  }
+
+  /*! Counters of the calling thread's pool !*/
+  static const pool_stats& stats()
+  {
+    return detail::pool::stats();
+  }
+
+  void* ptr           = nullptr;
+  const ops_t* ops    = nullptr;
+};
+
+/*! How a telemetry_storage placed and transferred one erased type, bytes
+ *  allocated only account for the objects themselves !*/
+struct type_telemetry {
+  const char* type;
+  std::size_t inline_placements;
+  std::size_t heap_placements;
+  std::size_t bytes_allocated;
+  std::size_t copies;
+  std::size_t moves;
+};
+
+namespace detail {
+template <class T>
+constexpr const char* pretty_function() noexcept {
+#if defined(_MSC_VER)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
+/*! T as spelt by the compiler in the signature of pretty_function<T>,
+ *  `... [with T = Square]`, `... [T = Square]` or
+ *  `... pretty_function<struct Square>(void) noexcept`, GCC may append
+ *  `; alias = ...` for aliases used in the signature !*/
+template <class T>
+constexpr std::string_view type_name_view() noexcept {
+  constexpr std::string_view name = pretty_function<T>();
+#if defined(_MSC_VER)
+  constexpr std::string_view prefix = "pretty_function<";
+  auto type = name.substr(name.find(prefix) + prefix.size());
+  type = type.substr(0, type.rfind(">(void)"));
+  for (std::string_view key : {"struct ", "class ", "union ", "enum "}) {
+    if (type.substr(0, key.size()) == key) {
+      return type.substr(key.size());
+    }
+  }
+  return type;
+#else
+  constexpr std::string_view prefix = "T = ";
+  auto type = name.substr(name.find(prefix) + prefix.size());
+  type = type.substr(0, type.rfind(']'));
+  return type.substr(0, type.find(';'));
+#endif
+}
+
+template <class T, std::size_t... Ns>
+inline constexpr char type_name_v[] = {type_name_view<T>()[Ns]..., '\0'};
+
+template <class T, std::size_t... Ns>
+constexpr const char* type_name(std::index_sequence<Ns...>) noexcept {
+  return type_name_v<T, Ns...>;
+}
+
+/*! Null terminated name of T, as used by te::telemetry !*/
+template <class T>
+constexpr const char* type_name() noexcept {
+  return type_name<T>(std::make_index_sequence<type_name_view<T>().size()>{});
+}
+
+template <class TStorage, class T, class = void>
+struct storage_fits_inline : std::false_type {};
+
+template <class TStorage, class T>
+struct storage_fits_inline<TStorage, T, std::void_t<typename TStorage::template type_fits<T>>>
+  : TStorage::template type_fits<T> {};
+
+struct type_counters {
+  type_counters(const char* type, bool local, std::size_t size, std::atomic<type_counters*>& head) noexcept
+    : type{type}, local{local}, size{size}, next{head.load(std::memory_order_relaxed)}
+  {
+    while (!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  }
+
+  const char* type;
+  bool local;
+  std::size_t size;
+  type_counters* next;
+  std::atomic<std::size_t> inline_placements{};
+  std::atomic<std::size_t> heap_placements{};
+  std::atomic<std::size_t> copies{};
+  std::atomic<std::size_t> moves{};
+};
+
+/*! Counters of the types placed by TStorage, in a list which is only ever
+ *  prepended to, so that reading it doesn't need a lock !*/
+template <class TStorage>
+class telemetry_registry {
+ public:
+  template <class T>
+  static type_counters& counters() {
+    static type_counters counters{
+      type_name<T>(),
+      storage_fits_inline<TStorage, T>::value || std::is_same_v<TStorage, non_owning_storage>,
+      sizeof(T),
+      head()
+    };
+    return counters;
+  }
+
+  static std::atomic<type_counters*>& head() {
+    static std::atomic<type_counters*> head{};
+    return head;
+  }
+};
+}  // namespace detail
+
+/*! Records per erased type how TStorage places it and how often it's copied
+ *  or moved, see te::telemetry. With WarnOnOverflow, the first heap placement
+ *  of each type is reported on stderr !*/
+template <class TStorage, bool WarnOnOverflow = false>
+struct telemetry_storage : TStorage
+{
+  template <
+    class T,
+    class T_ = std::decay_t<T>,
+    std::enable_if_t<!std::is_same_v<T_,telemetry_storage>, bool> = true
+  >
+  constexpr explicit telemetry_storage(T &&t) noexcept(std::is_nothrow_constructible_v<TStorage,T&&>)
+  : TStorage{std::forward<T>(t)},
+    counters{&detail::telemetry_registry<TStorage>::template counters<T_>()}
+  {
+    place();
+  }
+
+  template <class TAlloc, class T, class T_ = std::decay_t<T>>
+  constexpr telemetry_storage(std::allocator_arg_t, const TAlloc& alloc, T &&t)
+  : TStorage{std::allocator_arg, alloc, std::forward<T>(t)},
+    counters{&detail::telemetry_registry<TStorage>::template counters<T_>()}
+  {
+    place();
+  }
+
+  template <class T, class... Ts>
+  constexpr explicit telemetry_storage(std::in_place_type_t<T> type, Ts &&... args)
+  : TStorage{type, std::forward<Ts>(args)...},
+    counters{&detail::telemetry_registry<TStorage>::template counters<T>()}
+  {
+    place();
+  }
+
+  template <class T, class... Ts>
+  T& emplace(Ts &&... args)
+  {
+    auto& object = TStorage::template emplace<T>(std::forward<Ts>(args)...);
+    counters = &detail::telemetry_registry<TStorage>::template counters<T>();
+    place();
+    return object;
+  }
+
+  template <class T, class U>
+  auto assign(U &&value) -> decltype(std::declval<TStorage&>().template assign<T>(std::declval<U>()))
+  {
+    if (counters == &detail::telemetry_registry<TStorage>::template counters<T>())
+      return TStorage::template assign<T>(std::forward<U>(value));
+    return emplace<T>(std::forward<U>(value));
+  }
+
+  constexpr telemetry_storage(const telemetry_storage& other)
+  : TStorage{static_cast<const TStorage&>(other)}, counters{other.counters}
+  {
+    if (counters) {
+      counters->copies.fetch_add(1, std::memory_order_relaxed);
+      place();
+    }
+  }
+
+  constexpr telemetry_storage& operator=(const telemetry_storage& other)
+  {
+    if (this != &other) {
+      TStorage::operator=(static_cast<const TStorage&>(other));
+      counters = other.counters;
+      if (counters) {
+        counters->copies.fetch_add(1, std::memory_order_relaxed);
+        place();
+      }
+    }
+    return *this;
+  }
+
+  constexpr telemetry_storage(telemetry_storage&& other) noexcept(std::is_nothrow_move_constructible_v<TStorage>)
+  : TStorage{static_cast<TStorage&&>(other)}, counters{other.counters}
+  {
+    if (counters)
+      counters->moves.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  constexpr telemetry_storage& operator=(telemetry_storage&& other) noexcept(std::is_nothrow_move_assignable_v<TStorage>)
+  {
+    if (this != &other) {
+      TStorage::operator=(static_cast<TStorage&&>(other));
+      counters = other.counters;
+      if (counters)
+        counters->moves.fetch_add(1, std::memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  friend void swap(telemetry_storage& lhs, telemetry_storage& rhs) noexcept(std::is_nothrow_swappable_v<TStorage>)
+  {
+    using std::swap;
+    swap(static_cast<TStorage&>(lhs), static_cast<TStorage&>(rhs));
+    swap(lhs.counters, rhs.counters);
+  }
+
+ private:
+  void place() noexcept
+  {
+    if (counters->local) {
+      counters->inline_placements.fetch_add(1, std::memory_order_relaxed);
+    } else if (!counters->heap_placements.fetch_add(1, std::memory_order_relaxed) && WarnOnOverflow) {
+      std::fprintf(stderr, "te::telemetry_storage : %s is allocated on the heap (%zu bytes)\n",
+                   counters->type, counters->size);
+    }
+  }
+
+  detail::type_counters* counters = nullptr;
+};
+
+/*! Types placed by telemetry_storage<TStorage> so far, most recent first !*/
+template <class TStorage>
+std::vector<type_telemetry> telemetry() {
+  std::vector<type_telemetry> telemetry{};
+  for (auto* counters = detail::telemetry_registry<TStorage>::head().load(std::memory_order_acquire);
+       counters; counters = counters->next) {
+    const auto heap_placements = counters->heap_placements.load(std::memory_order_relaxed);
+    telemetry.push_back({
+      counters->type,
+      counters->inline_placements.load(std::memory_order_relaxed),
+      heap_placements,
+      heap_placements * counters->size,
+      counters->copies.load(std::memory_order_relaxed),
+      counters->moves.load(std::memory_order_relaxed)
+    });
+  }
+  return telemetry;
+}
+
+namespace detail {
+template <class T, class TExpr, class... TArgs>
+auto vtable_thunk(void *self, TArgs &&... args) {
+  return expr_wrapper<TExpr>{}(*static_cast<T *>(self),
+                               std::forward<TArgs>(args)...);
+}
+
+template <class T, class TExpr, class... TArgs>
+constexpr auto vtable_entry(type_list<TExpr, TArgs...>) noexcept {
+  return &vtable_thunk<T, TExpr, TArgs...>;
+}
+
+/*! One table per (interface, type), constant initialized and never written !*/
+template <class I, class T, std::size_t... Ns>
+inline void *const vtable_v[] = {reinterpret_cast<void *>(
+    vtable_entry<T>(decltype(get(mappings<I, Ns + 1>{})){}))...};
+
+template <class I, class T, std::size_t... Ns>
+constexpr void *const *vtable_for(std::index_sequence<Ns...>) noexcept {
+  return vtable_v<I, T, Ns...>;
+}
+
+/*! Not constexpr on purpose, so that it's instantiated after the interface
+ *  (explicitly instantiated class templates included) registered its calls !*/
+template <class I, class T>
+void *const *vtable_for() noexcept {
+  static_assert(mappings_size<I>() > 0);
+  return vtable_for<I, T>(std::make_index_sequence<mappings_size<I>()>{});
+}
+}  // namespace detail
+
+class static_vtable {
+  using ptr_t = void *const *;
+
+ public:
+  template <class I, class T>
+  constexpr explicit static_vtable(detail::type_list<I, T>,
+                                   ptr_t &vtable) noexcept {
+    vtable = detail::vtable_for<I, T>();
+  }
+};
+
+/*! Calls of one method of an interface, latencies are only sampled when
+ *  the instrumented_vtable is given a sampling period !*/
+struct slot_stats {
+  static constexpr std::size_t buckets = 32;
+
+  std::uint64_t calls;
+  std::uint64_t samples;
+  std::uint64_t histogram[buckets];  // [2^i, 2^(i+1)) ns
+};
+
+namespace detail {
+struct slot_counters {
+  std::atomic<std::uint64_t> calls{};
+  std::atomic<std::uint64_t> samples{};
+  std::atomic<std::uint64_t> histogram[slot_stats::buckets]{};
+};
+
+/*! Counters are written by their thread only and summed up on demand, the
+ *  ones of exited threads are kept and reused by the next ones !*/
+template <class I>
+class slot_registry {
+  struct block {
+    std::size_t size;
+    std::unique_ptr<slot_counters[]> slots;
+    bool used;
+  };
+
+  struct handle {
+    ~handle() {
+      if (used) {
+        std::lock_guard<std::mutex> lock{mutex()};
+        used->used = false;
+      }
+    }
+    block* used = nullptr;
+  };
+
+ public:
+  static slot_counters *local(std::size_t size) {
+    thread_local slot_counters *slots = nullptr;
+    if (not slots) {
+      slots = acquire(size);
+    }
+    return slots;
+  }
+
+  static std::vector<slot_stats> collect() {
+    std::vector<slot_stats> stats{};
+    std::lock_guard<std::mutex> lock{mutex()};
+    for (const auto &block : blocks()) {
+      stats.resize(std::max(stats.size(), block->size));
+      for (auto i = 0u; i < block->size; ++i) {
+        const auto &slot = block->slots[i];
+        stats[i].calls += slot.calls.load(std::memory_order_relaxed);
+        stats[i].samples += slot.samples.load(std::memory_order_relaxed);
+        for (auto b = 0u; b < slot_stats::buckets; ++b) {
+          stats[i].histogram[b] += slot.histogram[b].load(std::memory_order_relaxed);
+        }
+      }
+    }
+    return stats;
+  }
+
+ private:
+  static slot_counters *acquire(std::size_t size) {
+    thread_local handle handle{};
+    std::lock_guard<std::mutex> lock{mutex()};
+    for (auto &block : blocks()) {
+      if (not block->used and block->size == size) {
+        block->used = true;
+        return (handle.used = block.get())->slots.get();
+      }
+    }
+    blocks().push_back(std::make_unique<block>(
+        block{size, std::make_unique<slot_counters[]>(size), true}));
+    return (handle.used = blocks().back().get())->slots.get();
+  }
+
+  /*! Function local, as calls may happen during static initialization !*/
+  static std::mutex &mutex() {
+    static std::mutex mutex{};
+    return mutex;
+  }
+
+  static std::vector<std::unique_ptr<block> > &blocks() {
+    static std::vector<std::unique_ptr<block> > blocks{};
+    return blocks;
+  }
+};
+
+template <class T>
+void increment(std::atomic<T> &counter) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+class latency_sample final {
+ public:
+  explicit latency_sample(slot_counters &slot) noexcept : slot_{slot} {}
+
+  ~latency_sample() {
+    auto ns = std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - start_)
+                                .count());
+    auto bucket = 0u;
+    while (ns >>= 1 and bucket + 1 < slot_stats::buckets) {
+      ++bucket;
+    }
+    increment(slot_.samples);
+    increment(slot_.histogram[bucket]);
+  }
+
+ private:
+  slot_counters &slot_;
+  const std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+};
+
+template <std::size_t SamplingPeriod, class I, std::size_t Size, std::size_t N,
+          class T, class TExpr, class... TArgs>
+auto instrumented_thunk(void *self, TArgs &&... args) {
+  auto &slot = slot_registry<I>::local(Size)[N];
+  increment(slot.calls);
+  if constexpr (SamplingPeriod != 0) {
+    if (slot.calls.load(std::memory_order_relaxed) % SamplingPeriod == 0) {
+      const latency_sample sample{slot};
+      return vtable_thunk<T, TExpr, TArgs...>(self, std::forward<TArgs>(args)...);
+    }
+  }
+  return vtable_thunk<T, TExpr, TArgs...>(self, std::forward<TArgs>(args)...);
+}
+
+template <std::size_t SamplingPeriod, class I, std::size_t Size, std::size_t N,
+          class T, class TExpr, class... TArgs>
+constexpr auto instrumented_entry(type_list<TExpr, TArgs...>) noexcept {
+  return &instrumented_thunk<SamplingPeriod, I, Size, N, T, TExpr, TArgs...>;
+}
+
+template <std::size_t SamplingPeriod, class I, class T, std::size_t... Ns>
+inline void *const instrumented_vtable_v[] = {
+    reinterpret_cast<void *>(instrumented_entry<SamplingPeriod, I, sizeof...(Ns), Ns, T>(
+        decltype(get(mappings<I, Ns + 1>{})){}))...};
+
+template <std::size_t SamplingPeriod, class I, class T, std::size_t... Ns>
+constexpr void *const *instrumented_vtable_for(std::index_sequence<Ns...>) noexcept {
+  return instrumented_vtable_v<SamplingPeriod, I, T, Ns...>;
+}
+
+/*! Not constexpr on purpose, same as vtable_for !*/
+template <std::size_t SamplingPeriod, class I, class T>
+void *const *instrumented_vtable_for() noexcept {
+  static_assert(mappings_size<I>() > 0);
+  return instrumented_vtable_for<SamplingPeriod, I, T>(
+      std::make_index_sequence<mappings_size<I>()>{});
+}
+}  // namespace detail
+
+/*! Counts the calls of each method, and measures the latency of one call
+ *  in SamplingPeriod when it's not 0, see te::stats !*/
+template <std::size_t SamplingPeriod = 0>
+class instrumented_vtable {
+  using ptr_t = void *const *;
+
+ public:
+  template <class I, class T>
+  constexpr explicit instrumented_vtable(detail::type_list<I, T>,
+                                         ptr_t &vtable) noexcept {
+    vtable = detail::instrumented_vtable_for<SamplingPeriod, I, T>();
+  }
+};
+
+/*! Stats of the instrumented calls of I by all threads, indexed by the
+ *  order in which its methods were registered !*/
+template <class I>
+std::vector<slot_stats> stats() {
+  return detail::slot_registry<I>::collect();
+}
+
+namespace detail {
+/*! Address of the erased object, cached next to the vtable so that calls
+ *  don't have to ask the storage for it !*/
+struct poly_base {
+  void* const* vptr = nullptr;
+  void* ptr = nullptr;
+};
+
+template <class TStorage>
+constexpr void* storage_ptr(const TStorage& storage) noexcept {
+  return storage.ptr;
+}
+
+inline void* storage_ptr(const shared_storage& storage) noexcept {
+  return storage.ptr.get();
+}
+
+inline void* storage_ptr(const dynamic_storage& storage) noexcept {
+  return storage.get();
+}
+
+template <std::size_t Size, std::size_t Alignment, bool NothrowMove>
+void* storage_ptr(const local_storage<Size, Alignment, NothrowMove>& storage) noexcept {
+  return storage.get();
+}
+
+template <std::size_t Size, std::size_t Alignment, bool Copyable>
+void* storage_ptr(const sbo_storage<Size, Alignment, Copyable>& storage) noexcept {
+  return storage.get();
+}
+
+inline void* storage_ptr(const cacheline_storage& storage) noexcept {
+  return storage.get();
+}
+
+template <class TStorage, bool WarnOnOverflow>
+void* storage_ptr(const telemetry_storage<TStorage, WarnOnOverflow>& storage) noexcept {
+  return storage_ptr(static_cast<const TStorage&>(storage));
+}
+
+template <class T, class... Ts>
+constexpr std::size_t index_of() noexcept {
+  std::size_t index{}, i{};
+  (void)((std::is_same_v<T, Ts> ? (index = i, true) : (++i, false)) || ...);
+  return (std::is_same_v<T, Ts> || ...) ? index : sizeof...(Ts);
+}
+
+/*! Calls f(type_list<T>{}) for the index-th type, which the compiler turns
+ *  into a jump table !*/
+template <class F, class T, class... Ts>
+constexpr decltype(auto) visit_index(type_list<T, Ts...>, std::size_t index,
+                                     F &&f) {
+  if constexpr (sizeof...(Ts) == 0) {
+    return f(type_list<T>{});
+  } else {
+    if (index == 0) {
+      return f(type_list<T>{});
+    }
+    return visit_index(type_list<Ts...>{}, index - 1, std::forward<F>(f));
+  }
+}
+
+/*! Buffer and type index of a closed set of types, te::call dispatches
+ *  on the index when the interface derives from it !*/
+template <class... Ts>
+struct closed_base {
+  static constexpr std::size_t npos = sizeof...(Ts);
+
+  aligned_buffer<max_of(sizeof(Ts)...), max_of(alignof(Ts)...)> data;
+  std::size_t index = npos;
+};
+}  // namespace detail
+
+namespace detail {
+template <class TStorage, class = void>
+struct poly_alignment : std::integral_constant<std::size_t, 0> {};
+
+template <class TStorage>
+struct poly_alignment<TStorage, std::void_t<decltype(TStorage::poly_alignment)>>
+  : std::integral_constant<std::size_t, TStorage::poly_alignment> {};
+}  // namespace detail
+
+template <class I, class TStorage, class TVtable>
+class poly;
+
+namespace detail {
+/*! T itself when TStorage can be copied, otherwise a type nothing converts
+ *  to !*/
+template <class TStorage, class T>
+using copy_of_t = std::conditional_t<std::is_copy_constructible_v<TStorage>, T, move_only<T> >;
+}  // namespace detail
+
+namespace detail {
+template <class I, class TVtable, class TStorage>
+auto storage_of(const poly<I, TStorage, TVtable> *) -> type_list<TStorage>;
+template <class, class>
+auto storage_of(const void *) -> void;
+
+/*! Storages taking over the ownership of a smart pointer to the erased
+ *  type, instead of erasing the smart pointer itself !*/
+template <class TStorage, class TPtr>
+struct adopts : std::false_type {};
+
+template <class T>
+struct adopts<dynamic_storage, std::unique_ptr<T> > : std::true_type {};
+
+template <class T>
+struct adopts<unique_storage, std::unique_ptr<T> > : std::true_type {};
+
+template <class T>
+struct adopts<shared_storage, std::unique_ptr<T> > : std::true_type {};
+
+template <class T>
+struct adopts<shared_storage, std::shared_ptr<T> > : std::true_type {};
+
+/*! Storages which can assign a value to their erased object in place !*/
+template <class TStorage, class T, class U, class = void>
+struct assigns_in_place : std::false_type {};
+
+template <class TStorage, class T, class U>
+struct assigns_in_place<TStorage, T, U,
+    std::void_t<decltype(std::declval<TStorage&>().template assign<T>(std::declval<U>()))>>
+  : std::true_type {};
+
+/*! Storages taking an object handed over by a storage whose table is
+ *  TOps, copyable storages need the copy thunks !*/
+template <class TStorage, class TOps>
+struct takes_over : std::false_type {};
+
+template <>
+struct takes_over<dynamic_storage, copy_ops> : std::true_type {};
+
+template <std::size_t Size, std::size_t Alignment, bool NothrowMove>
+struct takes_over<local_storage<Size, Alignment, NothrowMove>, copy_ops> : std::true_type {};
+
+template <std::size_t Size, std::size_t Alignment, bool Copyable, class TOps>
+struct takes_over<sbo_storage<Size, Alignment, Copyable>, TOps>
+    : std::bool_constant<!Copyable || std::is_same_v<TOps, copy_ops>> {};
+
+template <>
+struct takes_over<cacheline_storage, copy_ops> : std::true_type {};
+
+template <class TOps>
+struct takes_over<unique_storage, TOps> : std::true_type {};
+
+template <class TOps>
+struct takes_over<shared_storage, TOps> : std::true_type {};
+
+/*! Storages handing their erased object over to other ones !*/
+template <class TStorage, class = void>
+struct hands_over : std::false_type {};
+
+template <class TStorage>
+struct hands_over<TStorage, std::void_t<decltype(std::declval<const TStorage&>().hand_over(false))>>
+    : std::true_type {};
+
+/*! Whether the erased object of TFrom can be handed over to TTo !*/
+template <class TFrom, class TTo, class = void>
+struct relocates : std::false_type {};
+
+template <class TFrom, class TTo>
+struct relocates<TFrom, TTo, std::enable_if_t<hands_over<TFrom>::value>>
+    : takes_over<TTo, typename TFrom::ops_t> {};
+
+template <class TStorage, class TList>
+struct converts_from : std::false_type {};
+
+template <class TStorage, class TOther>
+struct converts_from<TStorage, type_list<TOther>>
+    : std::bool_constant<!std::is_same_v<TOther, TStorage> && hands_over<TOther>::value &&
+                         takes_over<TStorage, copy_ops>::value> {};
+
+/*! Polys (or classes deriving from them) of the same interface and vtable
+ *  but a different storage are converted, not erased once more, when both
+ *  storages take part in handing objects over. Move only objects aren't
+ *  taken by copyable storages, such polys don't convert at all !*/
+template <class I, class TStorage, class TVtable, class T>
+struct is_convertible_poly
+    : converts_from<TStorage, decltype(storage_of<I, TVtable>(std::declval<T *>()))> {};
+}  // namespace detail
+
+/*! Storages may ask for the whole poly to be aligned, 0 has no effect !*/
+template <
+  class I,
+  class TStorage = dynamic_storage,
+  class TVtable = static_vtable
+>
+class alignas(detail::poly_alignment<TStorage>::value) poly : detail::poly_base,
+             TVtable,
+             public std::conditional_t<detail::is_complete<I>{}, I,
+                                       detail::type_list<I> > {
+ public:
+  template <
+    class T,
+    class T_ = std::decay_t<T>,
+    std::enable_if_t<!std::is_same_v<T_, poly> &&
+                     !detail::is_convertible_poly<I, TStorage, TVtable, T_>::value &&
+                     !detail::adopts<TStorage, T_>::value, bool> = true
+  >
+  constexpr poly(T &&t) // cppcheck-suppress noExplicitConstructor
+      noexcept(std::is_nothrow_constructible_v<T_,T&&>)
+      : poly{detail::type_list<T_, decltype(detail::requires__<I>(bool{}))>{},
+             std::forward<T>(t)} {}
+
+  /*! Constructs the erased T straight in the storage, which makes types
+   *  that can be neither copied nor moved erasable too !*/
+  template <class T, class... Ts>
+  constexpr explicit poly(std::in_place_type_t<T> type, Ts &&... args)
+      noexcept(std::is_nothrow_constructible_v<TStorage, std::in_place_type_t<T>, Ts&&...>)
+      : poly{detail::type_list<T, decltype(detail::requires__<I>(bool{}))>{},
+             type, std::forward<Ts>(args)...} {}
+
+  /*! Adopts the pointed to object as the erased one, see detail::adopts.
+   *  A null std::unique_ptr throws !*/
+  template <
+    class TPtr,
+    class TPtr_ = std::decay_t<TPtr>,
+    std::enable_if_t<detail::adopts<TStorage, TPtr_>::value, bool> = true
+  >
+  constexpr poly(TPtr &&object) // cppcheck-suppress noExplicitConstructor
+      : poly{detail::type_list<typename TPtr_::element_type,
+                               decltype(detail::requires__<I>(bool{}))>{},
+             std::forward<TPtr>(object)} {}
+
+  /*! Moves the erased object into this storage, keeping its vtable. Heap
+   *  objects are adopted when this storage can, see detail::relocates !*/
+  template <
+    class TOtherStorage,
+    std::enable_if_t<!std::is_same_v<TOtherStorage, TStorage> &&
+                     detail::relocates<TOtherStorage, TStorage>::value, bool> = true
+  >
+  constexpr poly(poly<I, TOtherStorage, TVtable> &&other) // cppcheck-suppress noExplicitConstructor
+      : poly{other, other.storage.hand_over(false)} {}
+
+  /*! Copies the erased object into this storage, keeping its vtable !*/
+  template <
+    class TOtherStorage,
+    std::enable_if_t<!std::is_same_v<TOtherStorage, TStorage> &&
+                     detail::relocates<TOtherStorage, TStorage>::value &&
+                     std::is_copy_constructible_v<TOtherStorage>, bool> = true
+  >
+  constexpr poly(const poly<I, TOtherStorage, TVtable> &other) // cppcheck-suppress noExplicitConstructor
+      : poly{other, other.storage.hand_over(true)} {}
+
+  template <
+    class TAlloc,
+    class T,
+    class T_ = std::decay_t<T>
+  >
+  constexpr poly(std::allocator_arg_t, const TAlloc &alloc, T &&t)
+      : poly{detail::type_list<T_, decltype(detail::requires__<I>(bool{}))>{},
+             std::allocator_arg, alloc, std::forward<T>(t)} {}
+
+  /*! Not a copy constructor with a move only storage, so that the implicit
+   *  one is deleted instead !*/
+  constexpr poly(detail::copy_of_t<TStorage, poly> const &other)
+      noexcept(std::is_nothrow_copy_constructible_v<TStorage>)
+      : detail::poly_base{other},
+        TVtable{other},
+        storage{other.storage} {
+    ptr = detail::storage_ptr(storage);
+  }
+
+  constexpr poly &operator=(detail::copy_of_t<TStorage, poly> const &other)
+      noexcept(std::is_nothrow_copy_constructible_v<TStorage>) {
+    ptr = nullptr;
+    storage = other.storage;
+    vptr = other.vptr;
+    ptr = detail::storage_ptr(storage);
+    return *this;
+  }
+
+  constexpr poly(poly &&other)
+      noexcept(std::is_nothrow_move_constructible_v<TStorage>)
+      : detail::poly_base{other},
+        TVtable{std::move(other)},
+        storage{std::move(other.storage)} {
+    ptr = detail::storage_ptr(storage);
+    other.ptr = detail::storage_ptr(other.storage);
+  }
+
+  constexpr poly &operator=(poly &&other)
+      noexcept(std::is_nothrow_move_constructible_v<TStorage>) {
+    ptr = nullptr;
+    storage = std::move(other.storage);
+    vptr = other.vptr;
+    ptr = detail::storage_ptr(storage);
+    other.ptr = detail::storage_ptr(other.storage);
+    return *this;
+  }
+
+  /*! Assigns to the erased object in place when it already is a T_, instead
+   *  of releasing the storage for a new one. The old object is kept when
+   *  constructing the new one throws !*/
+  template <
     class T,
     class T_ = std::decay_t<T>,
-    class TRequires
+    std::enable_if_t<!std::is_same_v<T_, poly> &&
+                     !detail::is_convertible_poly<I, TStorage, TVtable, T_>::value &&
+                     !detail::adopts<TStorage, T_>::value &&
+                     detail::assigns_in_place<TStorage, T_, T&&>::value, bool> = true
+  >
+  poly &operator=(T &&value) {
+    try {
+      storage.template assign<T_>(std::forward<T>(value));
+    } catch (...) {
+      ptr = detail::storage_ptr(storage);
+      throw;
+    }
+    static_cast<TVtable &>(*this) = TVtable{detail::type_list<I, T_>{}, vptr};
+    ptr = detail::storage_ptr(storage);
+    return *this;
+  }
+
+  /*! Replaces the erased object with a T constructed in place, the old
+   *  object is kept when the constructor throws !*/
+  template <class T, class... Ts>
+  T &emplace(Ts &&... args) {
+    static_assert(std::is_destructible_v<T>, "type must be desctructible");
+    T *object = nullptr;
+    try {
+      object = &storage.template emplace<T>(std::forward<Ts>(args)...);
+    } catch (...) {
+      ptr = detail::storage_ptr(storage);
+      throw;
+    }
+    static_cast<TVtable &>(*this) = TVtable{detail::type_list<I, T>{}, vptr};
+    ptr = detail::storage_ptr(storage);
+    return *object;
+  }
+
+  /*! Hands the erased object back when it is a T held by a dynamic_storage,
+   *  otherwise returns null and keeps it !*/
+  template <class T>
+  std::unique_ptr<T> into_unique() && {
+    static_assert(std::is_same_v<TStorage, dynamic_storage>,
+                  "into_unique requires a dynamic_storage");
+    auto object = storage.template into_unique<T>();
+    if (object) {
+      ptr = nullptr;
+    }
+    return object;
+  }
+
+  template <class, class, class>
+  friend class poly;
+
+  friend void swap(poly &lhs, poly &rhs)
+      noexcept(std::is_nothrow_swappable_v<TStorage>) {
+    using std::swap;
+    swap(lhs.storage, rhs.storage);
+    swap(lhs.vptr, rhs.vptr);
+    lhs.ptr = detail::storage_ptr(lhs.storage);
+    rhs.ptr = detail::storage_ptr(rhs.storage);
+  }
+
+ private:
+
+  template <
+    class T_,
+    class TRequires,
+    class... Ts
   >
-  constexpr explicit poly(T &&t, const TRequires) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-      : poly{std::forward<T>(t),
-             std::make_index_sequence<detail::mappings_size<I>()>{}} {}
+  constexpr explicit poly(detail::type_list<T_, TRequires>, Ts &&... args)
+      noexcept(std::is_nothrow_constructible_v<TStorage, Ts&&...>)
+      : detail::poly_base{},
+        TVtable{detail::type_list<I, T_>{}, vptr},
+        storage{std::forward<Ts>(args)...} {
+    ptr = detail::storage_ptr(storage);
+    static_assert(std::is_destructible_v<T_>, "type must be desctructible");
+  }
+
+  /*! The source gives up the objects this storage adopted !*/
+  template <class TPoly, class TOps>
+  constexpr poly(TPoly &other, detail::handover<TOps> &&from)
+      : detail::poly_base{other},
+        TVtable{other},
+        storage{from} {
+    ptr = detail::storage_ptr(storage);
+    if constexpr (!std::is_const_v<TPoly>) {
+      if (from.adopted) {
+        other.storage.release();
+        other.ptr = nullptr;
+      }
+    }
+  }
 
+  TStorage storage;
+};
+
+template <class I, class... Ts>
+class closed_poly : detail::poly_base,
+                    public detail::closed_base<Ts...>,
+                    public std::conditional_t<detail::is_complete<I>{}, I,
+                                              detail::type_list<I> > {
+  using closed_t = detail::closed_base<Ts...>;
+
+ public:
   template <
     class T,
     class T_ = std::decay_t<T>,
-    std::size_t... Ns
+    std::enable_if_t<detail::index_of<T_, Ts...>() != sizeof...(Ts), bool> = true
   >
-  constexpr explicit poly(T &&t, std::index_sequence<Ns...>) noexcept(std::is_nothrow_constructible_v<T_,T&&>)
-      : detail::poly_base{},
-        vtable{std::forward<T>(t), vptr,
-               std::integral_constant<std::size_t, sizeof...(Ns)>{}},
-        storage{std::forward<T>(t)} {
-    static_assert(sizeof...(Ns) > 0);
+  constexpr closed_poly(T &&t) // cppcheck-suppress noExplicitConstructor
+      noexcept(std::is_nothrow_constructible_v<T_,T&&>)
+      : closed_poly{detail::type_list<T_, decltype(detail::requires__<I>(bool{}))>{},
+                    std::forward<T>(t)} {}
+
+  constexpr closed_poly(closed_poly const &other)
+      noexcept((std::is_nothrow_copy_constructible_v<Ts> && ...))
+      : detail::poly_base{other}, closed_t{} {
+    ptr = &this->data;
+    copy_from(other);
+  }
+
+  constexpr closed_poly &operator=(closed_poly const &other)
+      noexcept((std::is_nothrow_copy_constructible_v<Ts> && ...)) {
+    if (&other != this) {
+      reset();
+      vptr = other.vptr;
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  constexpr closed_poly(closed_poly &&other)
+      noexcept((std::is_nothrow_move_constructible_v<Ts> && ...))
+      : detail::poly_base{other}, closed_t{} {
+    ptr = &this->data;
+    move_from(other);
+  }
+
+  constexpr closed_poly &operator=(closed_poly &&other)
+      noexcept((std::is_nothrow_move_constructible_v<Ts> && ...)) {
+    if (&other != this) {
+      reset();
+      vptr = other.vptr;
+      move_from(other);
+    }
+    return *this;
+  }
+
+  ~closed_poly() { reset(); }
+
+ private:
+  template <
+    class T_,
+    class TRequires,
+    class T
+  >
+  constexpr explicit closed_poly(detail::type_list<T_, TRequires>, T &&t)
+      noexcept(std::is_nothrow_constructible_v<T_,T&&>)
+      : detail::poly_base{}, closed_t{} {
     static_assert(std::is_destructible_v<T_>, "type must be desctructible");
-    static_assert(std::is_copy_constructible_v<T_> ||
-                  std::is_move_constructible_v<T_>,
-                  "type must be either copyable or moveable");
-    (init<Ns + 1, std::decay_t<T> >(
-         decltype(get(detail::mappings<I, Ns + 1>{})){}),
-     ...);
-  }
-
-  template <std::size_t N, class T, class TExpr, class... TArgs>
-  constexpr void init(detail::type_list<TExpr, TArgs...>) noexcept {
-    vptr[N - 1] = reinterpret_cast<void *>(+[](void *self, TArgs... args) {
-      return detail::expr_wrapper<TExpr>{}(*static_cast<T *>(self), args...);
-    });
+    vptr = detail::vtable_for<I, T_>();
+    ptr = &this->data;
+    new (&this->data) T_{std::forward<T>(t)};
+    this->index = detail::index_of<T_, Ts...>();
   }
 
-  void* ptr() const noexcept
-  {
-    if constexpr(std::is_same_v<TStorage, shared_storage>)
-      return storage.ptr.get();
+  constexpr void reset() noexcept {
+    if (this->index != closed_t::npos) {
+      detail::visit_index(detail::type_list<Ts...>{}, this->index, [this](auto type) {
+        destroy(type);
+      });
+      this->index = closed_t::npos;
+    }
+  }
+
+  template <class T>
+  constexpr void destroy(detail::type_list<T>) noexcept {
+    reinterpret_cast<T *>(&this->data)->~T();
+  }
+
+  constexpr void copy_from(const closed_poly &other) {
+    if (other.index != closed_t::npos) {
+      detail::visit_index(detail::type_list<Ts...>{}, other.index, [&](auto type) {
+        copy(type, other);
+      });
+      this->index = other.index;
+    }
+  }
+
+  template <class T>
+  constexpr void copy(detail::type_list<T>, const closed_poly &other) {
+    if constexpr(std::is_copy_constructible_v<T>)
+      new (&this->data) T{*reinterpret_cast<const T *>(&other.data)};
     else
-      return storage.ptr;
+      throw std::runtime_error("closed_poly : erased type is not copy constructible");
   }
 
-  TStorage storage;
-  TVtable vtable;
+  constexpr void move_from(closed_poly &other) {
+    if (other.index != closed_t::npos) {
+      detail::visit_index(detail::type_list<Ts...>{}, other.index, [&](auto type) {
+        move(type, other);
+      });
+      this->index = other.index;
+    }
+  }
+
+  template <class T>
+  constexpr void move(detail::type_list<T>, closed_poly &other) {
+    if constexpr(std::is_move_constructible_v<T>)
+      new (&this->data) T{std::move(*reinterpret_cast<T *>(&other.data))};
+    else
+      throw std::runtime_error("closed_poly : erased type is not move constructible");
+  }
+};
+
+#if defined(__cpp_lib_span)
+template <class T>
+using span = std::span<T>;
+#else
+/*! Contiguous objects of the same type, as handed to batch expressions !*/
+template <class T>
+class span {
+ public:
+  using element_type = T;
+
+  constexpr span() noexcept = default;
+  constexpr span(T *data, std::size_t size) noexcept : data_{data}, size_{size} {}
+
+  template <class U, class = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>{}> >
+  constexpr span(const span<U> &other) noexcept
+      : data_{other.data()}, size_{other.size()} {}
+
+  constexpr T *data() const noexcept { return data_; }
+  constexpr std::size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return !size_; }
+  constexpr T *begin() const noexcept { return data_; }
+  constexpr T *end() const noexcept { return data_ + size_; }
+  constexpr T &operator[](std::size_t index) const noexcept { return data_[index]; }
+
+ private:
+  T *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+#endif
+
+namespace detail {
+template <class TScalar, class TBatch>
+class batch_expr final {
+  static_assert(std::is_empty<TScalar>{} and std::is_empty<TBatch>{});
+
+ public:
+  using batch = TBatch;
+
+  template <class T, class... Ts>
+  constexpr decltype(auto) operator()(T &&self, Ts &&... args) const {
+    return expr_wrapper<TScalar>{}(std::forward<T>(self), std::forward<Ts>(args)...);
+  }
+};
+
+template <class TExpr, class T, class... Ts>
+struct has_batch : std::false_type {};
+
+template <class TScalar, class TBatch, class T, class... Ts>
+struct has_batch<batch_expr<TScalar, TBatch>, T, Ts...>
+    : std::is_invocable<const TBatch &, span<T>, Ts...> {};
+
+/*! Calls the expression on each of the size objects starting at self, so
+ *  that a whole segment costs a single erased call !*/
+template <class TExpr>
+class segment_expr final {
+  static_assert(std::is_empty<TExpr>{});
+
+ public:
+  template <class T, class TSize, class... Ts>
+  constexpr void operator()(T &self, TSize size, Ts &... args) const {
+    if constexpr (has_batch<TExpr, T, Ts &...>{}) {
+      expr_wrapper<typename TExpr::batch>{}(span<T>{&self, size}, args...);
+    } else {
+      for (auto *it = &self, *end = it + size; it != end; ++it) {
+        expr_wrapper<TExpr>{}(*it, args...);
+      }
+    }
+  }
+};
+
+struct segment_ops {
+  void (*del)(void*);
+  void* (*copy)(const void*);
+  void* (*data)(void*);
+  std::size_t (*size)(const void*);
+  void (*erase)(void*, std::size_t);
+};
+
+template <class T>
+inline constexpr segment_ops segment_ops_v{
+  [](void *self) {
+    delete static_cast<std::vector<T> *>(self);
+  },
+  [](const void *other) -> void * {
+    if constexpr(std::is_copy_constructible_v<T>)
+      return new std::vector<T>{*static_cast<const std::vector<T> *>(other)};
+    else
+      throw std::runtime_error("poly_collection : erased type is not copy constructible");
+  },
+  [](void *self) -> void * {
+    return static_cast<std::vector<T> *>(self)->data();
+  },
+  [](const void *self) {
+    return static_cast<const std::vector<T> *>(self)->size();
+  },
+  [](void *self, std::size_t index) {
+    auto &items = *static_cast<std::vector<T> *>(self);
+    items.erase(items.begin() + index);
+  }
+};
+
+/*! Calls of poly_collection<I>::for_each and types of its segments seen
+ *  so far in a TU, both only used to instantiate segment_thunk_v for
+ *  every pair of them, I's own mappings are left untouched !*/
+template <class I>
+struct segment_calls final {};
+
+template <class I>
+struct segment_types final {};
+
+/*! The thunk of one segment call for the segment type of ops, listed
+ *  at static initialization by every TU which saw both, so that no table
+ *  depends on what a single TU saw !*/
+struct segment_thunk {
+  segment_thunk(const segment_ops *ops, void *thunk,
+                std::atomic<const segment_thunk *> &head) noexcept
+      : ops{ops}, thunk{thunk}, next{head.load(std::memory_order_relaxed)} {
+    while (!head.compare_exchange_weak(next, this, std::memory_order_release,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  const segment_ops *ops;
+  void *thunk;
+  const segment_thunk *next;
+};
+
+template <class TCall>
+inline std::atomic<const segment_thunk *> segment_thunks_v{};
+
+template <class TCall, class T>
+inline const segment_thunk segment_thunk_v{
+    &segment_ops_v<T>, reinterpret_cast<void *>(vtable_entry<T>(TCall{})),
+    segment_thunks_v<TCall>};
+
+template <class TCall, class T>
+void *segment_thunk_of(const segment_ops *ops, type_list<T>) noexcept {
+  void(&segment_thunk_v<TCall, T>);
+  return ops == &segment_ops_v<T> ? reinterpret_cast<void *>(vtable_entry<T>(TCall{}))
+                                  : nullptr;
+}
+
+/*! Looks among the types seen before the call in its TU first, which
+ *  doesn't depend on static initialization having run, then in the list !*/
+template <class I, class TCall, std::size_t... Ns>
+void *segment_thunk_for(const segment_ops *ops, std::index_sequence<Ns...>) {
+  void *thunk = nullptr;
+  void((false || ... ||
+        (thunk = segment_thunk_of<TCall>(
+             ops, decltype(get(mappings<segment_types<I>, Ns + 1>{})){}))));
+  for (auto *it = segment_thunks_v<TCall>.load(std::memory_order_acquire);
+       !thunk && it; it = it->next) {
+    if (it->ops == ops) {
+      thunk = it->thunk;
+    }
+  }
+  if (!thunk) {
+    throw std::runtime_error("poly_collection : no TU saw both the call and the segment type");
+  }
+  return thunk;
+}
+
+template <class I, class T, std::size_t... Ns>
+void segment_thunks_of_calls(std::index_sequence<Ns...>) noexcept {
+  (void(&segment_thunk_v<decltype(get(mappings<segment_calls<I>, Ns + 1>{})), T>), ...);
+}
+}  // namespace detail
+
+namespace detail {
+template <class T, class I, class TStorage, class TVtable>
+auto fits_inline(const poly<I, TStorage, TVtable>*) -> storage_fits_inline<TStorage, T>;
+
+template <class T, class... Ts>
+auto fits_inline(const closed_base<Ts...>*) -> std::bool_constant<(std::is_same_v<T, Ts> || ...)>;
+}  // namespace detail
+
+/*! Whether TPoly stores T without allocating, for a poly and its interface !*/
+template <class TPoly, class T>
+struct fits_inline : decltype(detail::fits_inline<T>(static_cast<const TPoly*>(nullptr))) {};
+
+template <class TPoly, class T>
+inline constexpr bool fits_inline_v = fits_inline<TPoly, T>::value;
+
+/*! Pairs a per object expression with one taking a span of same typed
+ *  objects, the latter is used for whole segments when it's invocable !*/
+template <class TScalar, class TBatch>
+constexpr auto batch(const TScalar, const TBatch) noexcept {
+  return detail::batch_expr<TScalar, TBatch>{};
+}
+
+/*! Stores objects of each concrete type contiguously, in their own segment !*/
+template <class I>
+class poly_collection {
+ public:
+  class segment {
+    friend class poly_collection;
+
+   public:
+    std::size_t size() const noexcept { return ops->size(items); }
+    bool empty() const noexcept { return !size(); }
+    void erase(std::size_t index) { ops->erase(items, index); }
+
+    template <class T>
+    bool is() const noexcept {
+      return ops == &detail::segment_ops_v<T>;
+    }
+
+    template <class T>
+    std::vector<T> &get() const noexcept {
+      return *static_cast<std::vector<T> *>(items);
+    }
+
+    segment(const segment &other)
+        : items{other.ops->copy(other.items)}, ops{other.ops} {}
+
+    segment(segment &&other) noexcept
+        : items{detail::exchange(other.items, nullptr)}, ops{other.ops} {}
+
+    segment &operator=(segment other) noexcept {
+      std::swap(items, other.items);
+      std::swap(ops, other.ops);
+      return *this;
+    }
+
+    ~segment() {
+      if (items)
+        ops->del(items);
+    }
+
+   private:
+    template <class T>
+    explicit segment(detail::type_list<T>)
+        : items{new std::vector<T>{}}, ops{&detail::segment_ops_v<T>} {}
+
+    void* items;
+    const detail::segment_ops* ops;
+  };
+
+  template <class T, class T_ = std::decay_t<T>>
+  auto &insert(T &&t) {
+    return segment_of<T_>().emplace_back(std::forward<T>(t));
+  }
+
+  template <class T>
+  void erase(const T &element) {
+    auto &items = segment_of<T>();
+    items.erase(items.begin() + (&element - items.data()));
+  }
+
+  /*! Resolves the erased call once per segment and loops over it, deduced
+   *  return type so that the call is registered before the segments seen
+   *  later in the TU instantiate their thunks. Throws when no TU saw both
+   *  the call and the type of a segment !*/
+  template <class TExpr, class... Ts>
+  auto for_each(const TExpr, Ts &&... args) {
+    static_assert(std::is_empty<TExpr>{});
+    using call_t = detail::type_list<detail::segment_expr<TExpr>, std::size_t, Ts &...>;
+    using calls_t = detail::segment_calls<I>;
+    constexpr auto N = detail::mappings_size<calls_t, class for_each>() + 1;
+    void(typename detail::mappings<calls_t, N>::template set<call_t>{});
+    using types_t = std::make_index_sequence<
+        detail::mappings_size<detail::segment_types<I>, class for_each>()>;
+    for (const auto &segment : segments_) {
+      if (const auto size = segment.size()) {
+        reinterpret_cast<void (*)(void *, std::size_t &&, Ts &...)>(
+            detail::segment_thunk_for<I, call_t>(segment.ops, types_t{}))(
+            segment.ops->data(segment.items), std::size_t{size}, args...);
+      }
+    }
+  }
+
+  const std::vector<segment> &segments() const noexcept { return segments_; }
+  std::vector<segment> &segments() noexcept { return segments_; }
+
+  std::size_t size() const noexcept {
+    std::size_t size{};
+    for (const auto &segment : segments_) {
+      size += segment.size();
+    }
+    return size;
+  }
+
+  bool empty() const noexcept { return !size(); }
+  void clear() noexcept { segments_.clear(); }
+
+ private:
+  /*! Deduced return type so that the type is registered before the calls
+   *  seen later in the TU resolve their thunks !*/
+  template <class T>
+  auto &segment_of() {
+    using types_t = detail::segment_types<I>;
+    constexpr auto N = detail::mappings_size<types_t, class segment_of>() + 1;
+    void(typename detail::mappings<types_t, N>::template set<detail::type_list<T>>{});
+    detail::segment_thunks_of_calls<I, T>(std::make_index_sequence<
+        detail::mappings_size<detail::segment_calls<I>, class segment_of>()>{});
+    for (auto &segment : segments_) {
+      if (segment.template is<T>()) {
+        return segment.template get<T>();
+      }
+    }
+    return segments_.emplace_back(segment{detail::type_list<T>{}}).template get<T>();
+  }
+
+  std::vector<segment> segments_{};
 };
 
 namespace detail {
@@ -518,8 +2980,153 @@ constexpr auto call_impl(
 )
 {
   void(typename mappings<I, N>::template set<type_list<TExpr, Ts...> >{});
-  return reinterpret_cast<R (*)(void *, Ts...)>(self.vptr[N - 1])(
-      self.ptr(), std::forward<Ts>(args)...);
+  return reinterpret_cast<R (*)(void *, Ts &&...)>(self.vptr[N - 1])(
+      self.ptr, std::forward<Ts>(args)...);
+}
+
+template <class T>
+constexpr T *as(type_list<T>, void *ptr) noexcept {
+  return static_cast<T *>(ptr);
+}
+
+template <
+  class I,
+  std::size_t N,
+  class R,
+  class TExpr,
+  class... TTypes,
+  class... Ts
+>
+constexpr R call_impl(
+  const closed_base<TTypes...> &self,
+  std::integral_constant<std::size_t, N>,
+  type_list<R>,
+  const TExpr,
+  Ts &&... args
+)
+{
+  void(typename mappings<I, N>::template set<type_list<TExpr, Ts...> >{});
+  auto* ptr = const_cast<void *>(static_cast<const void *>(&self.data));
+  return visit_index(type_list<TTypes...>{}, self.index, [&](auto type) -> R {
+    return static_cast<R>(
+        expr_wrapper<TExpr>{}(*as(type, ptr), std::forward<Ts>(args)...));
+  });
+}
+
+template <class... Ts>
+constexpr const closed_base<Ts...> &dispatch_base(const closed_base<Ts...> *self) noexcept {
+  return *self;
+}
+
+constexpr const poly_base &dispatch_base(const void *self) noexcept {
+  return *static_cast<const poly_base *>(self);
+}
+
+/*! Numbers the distinct vtables in order of appearance, open addressing
+ *  as there are only a few of them compared to the objects !*/
+class vtable_ids {
+ public:
+  std::size_t operator()(const void *vptr) {
+    for (auto i = hash(vptr);; i = (i + 1) & (keys_.size() - 1)) {
+      if (keys_[i] == vptr) {
+        return ids_[i];
+      }
+      if (not keys_[i]) {
+        if (2 * (size_ + 1) > keys_.size()) {
+          grow();
+          return (*this)(vptr);
+        }
+        keys_[i] = vptr;
+        return ids_[i] = size_++;
+      }
+    }
+  }
+
+  std::size_t size() const noexcept { return size_; }
+
+ private:
+  std::size_t hash(const void *vptr) const noexcept {
+    return std::uint64_t(reinterpret_cast<std::uintptr_t>(vptr) >> 3) *
+               0x9E3779B97F4A7C15u >> shift_;
+  }
+
+  void grow() {
+    auto keys = std::move(keys_);
+    auto ids = std::move(ids_);
+    keys_.assign(2 * keys.size(), nullptr);
+    ids_.assign(keys_.size(), 0);
+    --shift_;
+    for (auto i = 0u; i < keys.size(); ++i) {
+      if (keys[i]) {
+        auto j = hash(keys[i]);
+        while (keys_[j]) {
+          j = (j + 1) & (keys_.size() - 1);
+        }
+        keys_[j] = keys[i];
+        ids_[j] = ids[i];
+      }
+    }
+  }
+
+  std::vector<const void *> keys_ = std::vector<const void *>(16);
+  std::vector<std::size_t> ids_ = std::vector<std::size_t>(16);
+  std::size_t size_ = 0;
+  unsigned shift_ = 64 - 4;
+};
+
+/*! Elements of the range counting sorted by their vtable, bounds[g] and
+ *  bounds[g + 1] delimit the group g, which keeps the relative order !*/
+template <class T>
+struct vtable_groups {
+  std::vector<T *> elements{};
+  std::vector<std::size_t> bounds{};
+};
+
+/*! Whether std::for_each takes TPolicy, so only for standard execution
+ *  policies, without pulling <execution> in !*/
+template <class TPolicy, class TIt, class TFunc>
+constexpr auto is_std_policy(bool)
+    -> decltype(std::for_each(std::declval<TPolicy>(), std::declval<TIt>(),
+                              std::declval<TIt>(), std::declval<TFunc>()),
+                bool{}) {
+  return true;
+}
+
+template <class, class, class>
+constexpr bool is_std_policy(...) {
+  return false;
+}
+
+template <class TRange>
+auto group_by_vtable(TRange &range) {
+  using element_t = std::remove_reference_t<decltype(*std::begin(range))>;
+  static_assert(std::is_base_of_v<poly_base, std::remove_cv_t<element_t>>,
+                "elements must be poly, closed_poly or poly_ref");
+  vtable_ids ids{};
+  std::vector<std::size_t> group_of{};
+  std::vector<std::size_t> sizes{};
+  for (auto &element : range) {
+    const auto id = ids(static_cast<const poly_base *>(
+                            static_cast<const void *>(std::addressof(element)))->vptr);
+    if (id == sizes.size()) {
+      sizes.push_back(0);
+    }
+    ++sizes[id];
+    group_of.push_back(id);
+  }
+
+  vtable_groups<element_t> groups{};
+  groups.bounds.resize(sizes.size() + 1);
+  for (auto i = 0u; i < sizes.size(); ++i) {
+    groups.bounds[i + 1] = groups.bounds[i] + sizes[i];
+    sizes[i] = groups.bounds[i];
+  }
+  groups.elements.resize(group_of.size());
+  auto i = 0u;
+  for (auto &element : range) {
+    groups.elements[sizes[group_of[i++]]++] = std::addressof(element);
+  }
+  return groups;
 }
 
 template <class I, class T, std::size_t... Ns>
@@ -552,7 +3159,7 @@ constexpr auto call(
 {
   static_assert(std::is_empty<TExpr>{});
   return detail::call_impl<I>(
-    reinterpret_cast<const detail::poly_base &>(interface),
+    detail::dispatch_base(std::addressof(interface)),
     std::integral_constant<std::size_t, detail::mappings_size<I, class call>() + 1>{},
     detail::type_list<R>{},
     expr,
@@ -560,12 +3167,163 @@ constexpr auto call(
   );
 }
 
+/*! Calls f for each poly of the range, one dynamic type after another, so
+ *  that the erased calls of a group always branch to the same target !*/
+template <class TRange, class TFunc>
+void grouped_for_each(TRange &&range, TFunc f) {
+  for (auto *element : detail::group_by_vtable(range).elements) {
+    f(*element);
+  }
+}
+
+/*! Same as above, with the groups spread across the execution policy.
+ *  Standard policies go to std::for_each, others to the for_each found
+ *  by ADL in the namespace of the policy !*/
+template <class TPolicy, class TRange, class TFunc>
+void grouped_for_each(TPolicy &&policy, TRange &&range, TFunc f) {
+  const auto groups = detail::group_by_vtable(range);
+  std::vector<std::size_t> indices(groups.bounds.size() - 1);
+  std::iota(indices.begin(), indices.end(), std::size_t{});
+  const auto each = [&](const std::size_t group) {
+    for (auto i = groups.bounds[group]; i != groups.bounds[group + 1]; ++i) {
+      f(*groups.elements[i]);
+    }
+  };
+  using it_t = typename std::vector<std::size_t>::iterator;
+  if constexpr (detail::is_std_policy<TPolicy, it_t, decltype(each)>(bool{})) {
+    std::for_each(std::forward<TPolicy>(policy), indices.begin(), indices.end(), each);
+  } else {
+    for_each(std::forward<TPolicy>(policy), indices.begin(), indices.end(), each);
+  }
+}
+
 template <class I, class T>
 constexpr auto extends(const T &) noexcept {
   detail::extends_impl<I, T>(
       std::make_index_sequence<detail::mappings_size<I, T>()>{});
 }
 
+namespace detail {
+template <class>
+struct callable;
+
+template <class R, class... Ts>
+struct callable<R(Ts...)> {
+  R operator()(Ts... args) const {
+    return te::call<R>(
+        [](auto &self, auto &&... args) -> R {
+          return self(std::forward<decltype(args)>(args)...);
+        },
+        *this, std::forward<Ts>(args)...);
+  }
+
+  template <class T>
+  auto requires__() -> decltype(&T::operator());
+};
+}  // namespace detail
+
+/*! Same as std::function but never empty, arguments are forwarded by
+ *  reference down to the callable !*/
+template <class TSignature, class TStorage = sbo_storage<2 * sizeof(void *)>>
+class function;
+
+template <class R, class... Ts, class TStorage>
+class function<R(Ts...), TStorage>
+    : public poly<detail::callable<R(Ts...)>, TStorage> {
+ public:
+  using poly<detail::callable<R(Ts...)>, TStorage>::poly;
+};
+
+/*! Same as function, but holds move only callables and can't be copied,
+ *  so that by default the callables don't get any copy code either !*/
+template <class TSignature, class TStorage = unique_sbo_storage<2 * sizeof(void *)>>
+class move_only_function;
+
+template <class R, class... Ts, class TStorage>
+class move_only_function<R(Ts...), TStorage>
+    : public poly<detail::callable<R(Ts...)>, TStorage> {
+ public:
+  using poly<detail::callable<R(Ts...)>, TStorage>::poly;
+
+  move_only_function(const move_only_function &) = delete;
+  move_only_function(move_only_function &&) = default;
+  move_only_function &operator=(const move_only_function &) = delete;
+  move_only_function &operator=(move_only_function &&) = default;
+};
+
+/*! Non-owning reference to any implementation of the interface, the
+ *  object address next to its vtable and nothing else. Const objects
+ *  aren't bound, the interface may modify them, same as non_owning_storage !*/
+template <class I>
+class poly_ref : detail::poly_base,
+                 public std::conditional_t<detail::is_complete<I>{}, I,
+                                           detail::type_list<I> > {
+ public:
+  template <
+    class T,
+    class T_ = std::remove_reference_t<T>,
+    std::enable_if_t<!std::is_same_v<std::remove_cv_t<T_>, poly_ref> &&
+                     !std::is_const_v<T_>, bool> = true
+  >
+  constexpr poly_ref(T &object) noexcept // cppcheck-suppress noExplicitConstructor
+      : poly_ref{detail::type_list<T_, decltype(detail::requires__<I>(bool{}))>{},
+                 object} {}
+
+ private:
+  template <class T_, class TRequires>
+  constexpr explicit poly_ref(detail::type_list<T_, TRequires>, T_ &object) noexcept
+      : detail::poly_base{detail::vtable_for<I, T_>(), std::addressof(object)} {}
+};
+
+/*! Non-owning callable, the object address next to the function that
+ *  invokes it, so that a call is a single indirect branch !*/
+template <class TSignature>
+class function_ref;
+
+template <class R, class... Ts>
+class function_ref<R(Ts...)> {
+  template <class T>
+  static constexpr auto is_function_v =
+      std::is_function_v<std::remove_pointer_t<std::decay_t<T> > >;
+
+ public:
+  template <
+    class T,
+    class T_ = std::remove_reference_t<T>,
+    std::enable_if_t<!std::is_same_v<std::decay_t<T>, function_ref> &&
+                     std::is_invocable_r_v<R, T_ &, Ts...>, bool> = true
+  >
+  constexpr function_ref(T &&object) noexcept // cppcheck-suppress noExplicitConstructor
+      : object_{address(object)},
+        thunk_{&invoke<std::conditional_t<is_function_v<T>, std::decay_t<T>, T_> >} {}
+
+  constexpr R operator()(Ts... args) const {
+    return thunk_(object_, std::forward<Ts>(args)...);
+  }
+
+ private:
+  template <class T>
+  static constexpr void *address(T &object) noexcept {
+    if constexpr (is_function_v<T>) {
+      return reinterpret_cast<void *>(+object);
+    } else {
+      return const_cast<void *>(static_cast<const void *>(std::addressof(object)));
+    }
+  }
+
+  template <class T>
+  static R invoke(void *object, Ts &&... args) {
+    if constexpr (std::is_pointer_v<T>) {
+      return static_cast<R>(reinterpret_cast<T>(object)(std::forward<Ts>(args)...));
+    } else {
+      return static_cast<R>((*static_cast<T *>(object))(std::forward<Ts>(args)...));
+    }
+  }
+
+  void *object_ = nullptr;
+  R (*thunk_)(void *, Ts &&...) = nullptr;
+};
+
 #if defined(__cpp_concepts)
 template <class I, class T>
 concept var = requires {
@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <sstream>
+
+#include "boost/te.hpp"
+#include "common/test.hpp"
+
+namespace te = boost::te;
+
+static std::size_t allocations = 0;
+
+/*! Every replaceable operator new goes through here, so that none of them
+ *  allocates unnoticed !*/
+static void *allocate(std::size_t size, std::size_t alignment) noexcept {
+  ++allocations;
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size ? size : 1);
+  }
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+static void *allocate_or_throw(std::size_t size, std::size_t alignment) {
+  if (auto *ptr = allocate(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+/*! Kept out of line, GCC otherwise inlines the free() into callers and
+ *  warns that it doesn't match the operator new it can't see into !*/
+[[gnu::noinline]] static void deallocate(void *ptr) noexcept { std::free(ptr); }
+
+constexpr auto default_alignment = alignof(std::max_align_t);
+
+void *operator new(std::size_t size) { return allocate_or_throw(size, default_alignment); }
+void *operator new[](std::size_t size) { return allocate_or_throw(size, default_alignment); }
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size, default_alignment);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size, default_alignment);
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { deallocate(ptr); }
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept {
+  deallocate(ptr);
+}
+
+/*! Heap allocations made while running fn !*/
+template <class Fn>
+std::size_t allocations_of(const Fn &fn) {
+  const auto before = allocations;
+  fn();
+  return allocations - before;
+}
+
+struct Drawable {
+  void draw(std::ostream &out) const {
+    te::call([](auto const &self, auto &out) { self.draw(out); }, *this, out);
+  }
+};
+
+struct Square {
+  void draw(std::ostream &out) const { out << side; }
+  int side{};
+};
+
+struct Large {
+  void draw(std::ostream &out) const { out << data[0]; }
+  int data[16]{};
+};
+
+struct LargeToo {
+  void draw(std::ostream &out) const { out << data[1]; }
+  int data[16]{};
+};
+
+struct alignas(64) Aligned {
+  void draw(std::ostream &out) const { out << data[0]; }
+  int data[16]{};
+};
+
+struct budget {
+  std::size_t construct, copy, move, copy_assign, move_assign, call;
+};
+
+/*! Fails when an erased operation allocates more than its budget !*/
+template <class TPoly, class T>
+void expect_budget(T object, budget budget) {
+  std::stringstream out{};
+  out << 42;  // let the stream allocate its buffer up front
+
+  TPoly poly{object};
+  TPoly other{object};
+
+  expect(budget.construct >= allocations_of([&] { TPoly drawable{object}; }));
+  expect(budget.copy >= allocations_of([&] { TPoly copy{poly}; }));
+  std::optional<TPoly> moved{};
+  expect(budget.move >= allocations_of([&] { moved.emplace(std::move(poly)); }));
+  expect(budget.move_assign >= allocations_of([&] { poly = std::move(*moved); }));
+  expect(budget.copy_assign >= allocations_of([&] { other = poly; }));
+  TPoly copy{poly};
+  expect(budget.move_assign >= allocations_of([&] { other = std::move(copy); }));
+  expect(budget.call >= allocations_of([&] { poly.draw(out); }));
+}
+
+test should_not_allocate_more_than_budgeted_dynamic_storage = [] {
+  expect_budget<te::poly<Drawable, te::dynamic_storage>>(Square{}, {0, 0, 0, 0, 0, 0});
+  expect_budget<te::poly<Drawable, te::dynamic_storage>>(Large{}, {1, 1, 0, 0, 0, 0});
+};
+
+test should_count_every_form_of_operator_new = [] {
+  std::stringstream out{};
+  out << 42;
+  expect(1 == allocations_of([&] {
+           te::poly<Drawable> drawable{Aligned{}};
+           drawable.draw(out);
+         }));
+
+  constexpr auto alignment = std::align_val_t{64};
+  expect(1 == allocations_of([] { ::operator delete[](::operator new[](16)); }));
+  expect(1 == allocations_of([] { ::operator delete(::operator new(16, std::nothrow)); }));
+  expect(1 == allocations_of([&] {
+           ::operator delete[](::operator new[](64, alignment, std::nothrow), alignment);
+         }));
+};
+
+test should_not_allocate_more_than_budgeted_shared_storage = [] {
+  expect_budget<te::poly<Drawable, te::shared_storage>>(Square{}, {1, 0, 0, 0, 0, 0});
+};
+
+test should_not_allocate_more_than_budgeted_local_storage = [] {
+  expect_budget<te::poly<Drawable, te::local_storage<16>>>(Square{}, {0, 0, 0, 0, 0, 0});
+};
+
+test should_not_allocate_more_than_budgeted_sbo_storage = [] {
+  expect_budget<te::poly<Drawable, te::sbo_storage<16>>>(Square{}, {0, 0, 0, 0, 0, 0});
+  expect_budget<te::poly<Drawable, te::sbo_storage<16>>>(Large{}, {1, 1, 0, 0, 0, 0});
+};
+
+test should_not_allocate_more_than_budgeted_non_owning_storage = [] {
+  expect_budget<te::poly<Drawable, te::non_owning_storage>>(Square{}, {0, 0, 0, 0, 0, 0});
+};
+
+test should_not_allocate_more_than_budgeted_allocator_storage = [] {
+  expect_budget<te::poly<Drawable, te::allocator_storage<>>>(Square{}, {1, 1, 0, 1, 0, 0});
+};
+
+test should_not_allocate_more_than_budgeted_pooled_storage = [] {
+  {
+    using poly_t = te::poly<Drawable, te::pooled_storage>;
+    poly_t warm_up[]{Square{}, Square{}, Square{}, Square{}, Square{}};
+  }
+  expect_budget<te::poly<Drawable, te::pooled_storage>>(Square{}, {0, 0, 0, 0, 0, 0});
+};
+
+test should_not_allocate_more_than_budgeted_closed_poly = [] {
+  expect_budget<te::closed_poly<Drawable, Square, Large>>(Square{}, {0, 0, 0, 0, 0, 0});
+};
+
+test should_not_allocate_when_adopting_smart_pointers = [] {
+  auto unique = std::make_unique<Square>();
+  expect(0 == allocations_of([&] { te::poly<Drawable> drawable{std::move(unique)}; }));
+
+  auto shared = std::make_shared<Square>();
+  expect(0 == allocations_of([&] { te::poly<Drawable, te::shared_storage> drawable{shared}; }));
+};
+
+test should_reuse_the_storage_when_reassigning = [] {
+  te::poly<Drawable> drawable{Large{}};
+  expect(0 == allocations_of([&] { drawable = Large{}; }));
+  expect(0 == allocations_of([&] { drawable = LargeToo{}; }));
+  expect(0 == allocations_of([&] { drawable = Square{}; }));
+  expect(1 == allocations_of([&] { drawable = Large{}; }));
+
+  te::poly<Drawable, te::sbo_storage<16>> sbo{Large{}};
+  expect(0 == allocations_of([&] { sbo = Large{}; }));
+
+  te::poly<Drawable, te::telemetry_storage<te::dynamic_storage>> counted{Large{}};
+  expect(0 == allocations_of([&] { counted = Large{}; }));
+};
+
+struct Empty {
+  void draw(std::ostream &) const {}
+};
+
+test should_not_allocate_for_empty_and_pointer_sized_types = [] {
+  expect_budget<te::poly<Drawable, te::dynamic_storage>>(Empty{}, {0, 0, 0, 0, 0, 0});
+  expect_budget<te::poly<Drawable, te::shared_storage>>(Empty{}, {0, 0, 0, 0, 0, 0});
+
+  expect(0 == allocations_of([] {
+           te::function<int(int), te::dynamic_storage> f{[](int i) { return i; }};
+           auto copy = f;
+           (void)copy(42);
+         }));
+};
+
+test should_adopt_heap_objects_when_converting_between_storages = [] {
+  te::poly<Drawable, te::sbo_storage<16>> sbo{Large{}};
+  expect(0 == allocations_of([&] { te::poly<Drawable> drawable{std::move(sbo)}; }));
+
+  te::poly<Drawable> dynamic{Large{}};
+  expect(0 == allocations_of([&] { te::poly<Drawable, te::unique_storage> unique{std::move(dynamic)}; }));
+
+  te::poly<Drawable> copied{Large{}};
+  expect(1 == allocations_of([&] { te::poly<Drawable, te::sbo_storage<16>> copy{copied}; }));
+};
@@ -0,0 +1,50 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <sstream>
+#include <stdexcept>
+
+#include "poly_collection.hpp"
+#include "common/test.hpp"
+
+test should_resolve_for_each_calls_in_their_own_tu = [] {
+  te::poly_collection<Drawable> drawables{};
+  drawables.insert(Square{});
+  insert_in_other_tu(drawables);
+
+  {
+    std::stringstream str{};
+    drawables.for_each([](auto const &self, auto &out) { self.draw(out); }, str);
+    expect("SquareSquare" == str.str());
+  }
+
+  expect("other:Squareother:Square" == draw_in_other_tu(drawables));
+
+  {
+    std::stringstream str{};
+    drawables.for_each(
+        [](auto const &self, auto &out) {
+          out << "this:";
+          self.draw(out);
+        },
+        str);
+    expect("this:Squarethis:Square" == str.str());
+  }
+};
+
+test should_throw_when_no_tu_saw_the_call_and_the_segment_type = [] {
+  te::poly_collection<Drawable> drawables{};
+  drawables.insert(Circle{});
+
+  auto thrown = false;
+  try {
+    draw_in_other_tu(drawables);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  expect(thrown);
+};
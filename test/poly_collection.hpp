@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "boost/te.hpp"
+
+namespace te = boost::te;
+
+struct Drawable {
+  void draw(std::ostream &out) const {
+    te::call([](auto const &self, auto &out) { self.draw(out); }, *this, out);
+  }
+};
+
+struct Square {
+  void draw(std::ostream &out) const { out << "Square"; }
+};
+
+struct Circle {
+  void draw(std::ostream &out) const { out << "Circle"; }
+};
+
+/*! Defined in poly_collection_other.cpp, which sees its own for_each call
+ *  and only Squares !*/
+void insert_in_other_tu(te::poly_collection<Drawable> &drawables);
+std::string draw_in_other_tu(te::poly_collection<Drawable> &drawables);
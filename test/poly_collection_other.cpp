@@ -0,0 +1,25 @@
+//
+// Copyright (c) 2018-2019 Kris Jusiak (kris at jusiak dot net)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+#include <sstream>
+
+#include "poly_collection.hpp"
+
+void insert_in_other_tu(te::poly_collection<Drawable> &drawables) {
+  drawables.insert(Square{});
+}
+
+std::string draw_in_other_tu(te::poly_collection<Drawable> &drawables) {
+  std::stringstream str{};
+  drawables.for_each(
+      [](auto const &self, auto &out) {
+        out << "other:";
+        self.draw(out);
+      },
+      str);
+  return str.str();
+}
@@ -5,10 +5,17 @@
 // (See accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 //
+#include <array>
 #include <sstream>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 #include <cstring>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <algorithm>
 
 #include "boost/te.hpp"
 #include "common/test.hpp"
@@ -120,6 +127,55 @@ test should_erase_the_call_using_macro = [] {
   }
 };
 
+test should_share_vtable_per_interface_and_type = [] {
+  const auto vptr = [](const auto &poly) {
+    return reinterpret_cast<const te::detail::poly_base &>(poly).vptr;
+  };
+
+  te::poly<Drawable> square1{Square{}};
+  te::poly<Drawable> square2{Square{}};
+  te::poly<Drawable> circle{Circle{}};
+  te::poly<DrawableMacro> square_macro{Square{}};
+
+  expect(vptr(square1) == vptr(square2));
+  expect(vptr(square1) != vptr(circle));
+  expect(vptr(square1) != vptr(square_macro));
+};
+
+test should_keep_the_object_address_next_to_the_vtable = [] {
+  static_assert(sizeof(te::poly<Drawable, te::non_owning_storage>) ==
+                sizeof(te::non_owning_storage) + 2 * sizeof(void *));
+  static_assert(sizeof(te::poly<Drawable>) ==
+                sizeof(te::dynamic_storage) + 2 * sizeof(void *));
+  static_assert(!std::is_polymorphic_v<te::poly<Drawable>>);
+
+  const auto ptr = [](const auto &poly) {
+    return reinterpret_cast<const te::detail::poly_base &>(poly).ptr;
+  };
+
+  te::poly<Drawable, te::local_storage<16>> square{Square{}};
+  te::poly<Drawable, te::local_storage<16>> copy{square};
+  te::poly<Drawable, te::local_storage<16>> move{std::move(copy)};
+  expect(ptr(square) != ptr(move));
+
+  std::stringstream str{};
+  move.draw(str);
+  square = move;
+  square.draw(str);
+  expect("SquareSquare" == str.str());
+};
+
+test should_keep_storages_compact = [] {
+  static_assert(sizeof(te::dynamic_storage) == 2 * sizeof(void *));
+  static_assert(sizeof(te::local_storage<16>) == 16 + sizeof(void *));
+  static_assert(sizeof(te::sbo_storage<16>) == 16 + sizeof(void *));
+  static_assert(sizeof(te::sbo_storage<2>) == 2 * sizeof(void *));
+  static_assert(sizeof(te::poly<Drawable, te::sbo_storage<16>>) ==
+                16 + 3 * sizeof(void *));
+  static_assert(sizeof(te::poly<Drawable, te::local_storage<16>>) ==
+                16 + 3 * sizeof(void *));
+};
+
 struct DrawableDeclareCustomStorage
     : te::poly<DrawableDeclare, te::local_storage<16>> {
   using te::poly<DrawableDeclare, te::local_storage<16>>::poly;
@@ -378,6 +434,291 @@ test should_support_containers = [] {
   expect("SquareCircleTriangle" == str.str());
 };
 
+struct CountedSquare {
+  static inline auto copies = 0;
+  static inline auto moves = 0;
+
+  CountedSquare() = default;
+  CountedSquare(const CountedSquare &) { ++copies; }
+  CountedSquare(CountedSquare &&) noexcept { ++moves; }
+
+  void draw(std::ostream &out) const { out << "Square"; }
+};
+
+struct ThrowingMoveSquare {
+  ThrowingMoveSquare() = default;
+  ThrowingMoveSquare(const ThrowingMoveSquare &) = default;
+  ThrowingMoveSquare(ThrowingMoveSquare &&) noexcept(false) {}
+
+  void draw(std::ostream &out) const { out << "Square"; }
+};
+
+struct FailingMoveSquare {
+  FailingMoveSquare() = default;
+  FailingMoveSquare(const FailingMoveSquare &) = default;
+  FailingMoveSquare(FailingMoveSquare &&) { throw std::runtime_error{"move"}; }
+
+  void draw(std::ostream &out) const { out << "Square"; }
+};
+
+template <class TStorage>
+void container_growth() {
+  static_assert(
+      std::is_nothrow_move_constructible_v<te::poly<Drawable, TStorage>>);
+  static_assert(std::is_nothrow_swappable_v<te::poly<Drawable, TStorage>>);
+
+  CountedSquare::copies = 0;
+  std::vector<te::poly<Drawable, TStorage>> drawables{};
+  for (auto i = 0; i < 1024; ++i) {
+    drawables.emplace_back(CountedSquare{});
+    drawables.emplace_back(Circle{});
+  }
+  expect(0 == CountedSquare::copies);
+
+  std::stringstream str{};
+  drawables[0].draw(str);
+  drawables[1].draw(str);
+  expect("SquareCircle" == str.str());
+}
+
+test should_not_copy_on_container_growth = [] {
+  container_growth<te::local_storage<16, 8, true>>();
+  container_growth<te::sbo_storage<16>>();
+  container_growth<te::sbo_storage<0>>();
+};
+
+test should_relocate_trivially_copyable_types = [] {
+  static_assert(te::is_trivially_relocatable_v<Square>);
+  static_assert(!te::is_trivially_relocatable_v<CountedSquare>);
+
+  const auto ptr = [](const auto &poly) {
+    return reinterpret_cast<const te::detail::poly_base &>(poly).ptr;
+  };
+
+  {
+    te::poly<Drawable, te::local_storage<16>> square{Square{}};
+    te::poly<Drawable, te::local_storage<16>> moved{std::move(square)};
+    expect(nullptr == ptr(square));
+    expect(nullptr != ptr(moved));
+  }
+
+  {
+    CountedSquare::moves = 0;
+    te::poly<Drawable, te::sbo_storage<16>> square{CountedSquare{}};
+    te::poly<Drawable, te::sbo_storage<16>> moved{std::move(square)};
+    expect(2 == CountedSquare::moves);
+    expect(nullptr != ptr(square));
+  }
+};
+
+test should_swap_inline_storages = [] {
+  te::poly<Drawable, te::sbo_storage<16>> lhs{Square{}};
+  te::poly<Drawable, te::sbo_storage<16>> rhs{CountedSquare{}};
+  te::poly<Drawable, te::sbo_storage<16>> circle{Circle{}};
+
+  CountedSquare::copies = 0;
+  swap(lhs, circle);
+  swap(lhs, rhs);
+  expect(0 == CountedSquare::copies);
+
+  std::stringstream str{};
+  lhs.draw(str);
+  rhs.draw(str);
+  circle.draw(str);
+  expect("SquareCircleSquare" == str.str());
+};
+
+test should_move_throwing_move_types_without_terminating = [] {
+  static_assert(not te::sbo_storage<16>::type_fits<ThrowingMoveSquare>::value);
+  static_assert(not te::unique_sbo_storage<16>::type_fits<ThrowingMoveSquare>::value);
+  static_assert(te::local_storage<16>::type_fits<ThrowingMoveSquare>::value);
+  static_assert(not te::local_storage<16, 8, true>::type_fits<ThrowingMoveSquare>::value);
+  static_assert(std::is_nothrow_move_constructible_v<te::poly<Drawable, te::sbo_storage<16>>>);
+  static_assert(not std::is_nothrow_move_constructible_v<te::poly<Drawable, te::local_storage<16>>>);
+
+  te::poly<Drawable, te::sbo_storage<16>> drawable{std::in_place_type<FailingMoveSquare>};
+  auto moved = std::move(drawable);
+
+  te::poly<Drawable, te::local_storage<16>> local{std::in_place_type<FailingMoveSquare>};
+  auto thrown = false;
+  try {
+    auto local_moved = std::move(local);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  expect(thrown);
+
+  std::stringstream str{};
+  moved.draw(str);
+  local.draw(str);
+  expect("SquareSquare" == str.str());
+};
+
+struct Shape : te::closed_poly<Shape, Square, Circle, Triangle> {
+  using te::closed_poly<Shape, Square, Circle, Triangle>::closed_poly;
+
+  void draw(std::ostream &out) const {
+    te::call([](auto const &self, auto &out) { self.draw(out); }, *this, out);
+  }
+};
+
+test should_support_closed_poly = [] {
+  static_assert(sizeof(Shape) ==
+                sizeof(te::detail::poly_base) + 2 * sizeof(std::size_t));
+  static_assert(std::is_convertible_v<Square, Shape>);
+  static_assert(!std::is_convertible_v<CountedSquare, Shape>);
+
+  std::vector<Shape> shapes{};
+  shapes.push_back(Square{});
+  shapes.push_back(Circle{});
+  shapes.push_back(Triangle{});
+
+  Shape copy{shapes[1]};
+  shapes.push_back(copy);
+  shapes[0] = Triangle{};
+
+  std::stringstream str{};
+  for (const auto &shape : shapes) {
+    shape.draw(str);
+  }
+  expect("TriangleCircleTriangleCircle" == str.str());
+};
+
+test should_support_closed_poly_with_interface = [] {
+  using drawable_t = te::closed_poly<Drawable, Square, Circle>;
+
+  drawable_t drawable{Square{}};
+  drawable_t other{std::move(drawable)};
+  other = Circle{};
+
+  std::stringstream str{};
+  drawable.draw(str);
+  other.draw(str);
+  expect("SquareCircle" == str.str());
+};
+
+test should_support_poly_collection = [] {
+  te::poly_collection<Drawable> drawables{};
+  expect(drawables.empty());
+
+  drawables.insert(Square{});
+  drawables.insert(Circle{});
+  auto &square = drawables.insert(Square{});
+  drawables.insert(Triangle{});
+  expect(4 == drawables.size());
+  expect(3 == drawables.segments().size());
+  expect(drawables.segments()[0].is<Square>());
+  expect(2 == drawables.segments()[0].get<Square>().size());
+
+  {
+    std::stringstream str{};
+    drawables.for_each([](auto const &self, auto &out) { self.draw(out); }, str);
+    expect("SquareSquareCircleTriangle" == str.str());
+  }
+
+  drawables.erase(square);
+  drawables.segments()[1].erase(0);
+  expect(2 == drawables.size());
+
+  auto copy = drawables;
+  drawables.clear();
+  expect(drawables.empty());
+
+  {
+    std::stringstream str{};
+    copy.for_each([](auto const &self, auto &out) { self.draw(out); }, str);
+    expect("SquareTriangle" == str.str());
+  }
+};
+
+namespace policy {
+struct serial {};
+
+template <class TIt, class TFunc>
+void for_each(serial, TIt first, TIt last, TFunc f) {
+  std::for_each(first, last, f);
+}
+}  // namespace policy
+
+test should_group_calls_by_dynamic_type = [] {
+  std::vector<te::poly<Drawable>> drawables{};
+  drawables.push_back(Square{});
+  drawables.push_back(Circle{});
+  drawables.push_back(Square{});
+  drawables.push_back(Triangle{});
+  drawables.push_back(Circle{});
+
+  const auto groups = [](const std::vector<std::string> &names) {
+    auto groups = 1;
+    for (auto i = 1u; i < names.size(); ++i) {
+      groups += names[i] != names[i - 1];
+    }
+    return groups;
+  };
+
+  {
+    std::vector<std::string> names{};
+    te::grouped_for_each(drawables, [&](const auto &drawable) {
+      std::stringstream str{};
+      drawable.draw(str);
+      names.push_back(str.str());
+    });
+    expect(5 == names.size());
+    expect(3 == groups(names));
+  }
+
+  {
+    std::vector<std::string> names{};
+    te::grouped_for_each(policy::serial{}, drawables,
+                         [&](const auto &drawable) {
+                           std::stringstream str{};
+                           drawable.draw(str);
+                           names.push_back(str.str());
+                         });
+    expect(5 == names.size());
+    expect(3 == groups(names));
+  }
+};
+
+struct SquareBatch {
+  void draw(std::ostream &out) const { out << "Square"; }
+};
+
+void draw_n(te::span<const SquareBatch> squares, std::ostream &out) {
+  out << squares.size() << "xSquare";
+}
+
+struct DrawableBatch {
+  static constexpr auto draw_expr = te::batch(
+      [](auto const &self, auto &out) { self.draw(out); },
+      [](auto self, auto &out) -> decltype(draw_n(self, out)) {
+        draw_n(self, out);
+      });
+
+  void draw(std::ostream &out) const { te::call(draw_expr, *this, out); }
+};
+
+test should_support_batch_expressions = [] {
+  te::poly_collection<DrawableBatch> drawables{};
+  drawables.insert(SquareBatch{});
+  drawables.insert(Circle{});
+  drawables.insert(SquareBatch{});
+  drawables.insert(Circle{});
+
+  {
+    std::stringstream str{};
+    drawables.for_each(DrawableBatch::draw_expr, str);
+    expect("2xSquareCircleCircle" == str.str());
+  }
+
+  {
+    std::stringstream str{};
+    te::poly<DrawableBatch> drawable{SquareBatch{}};
+    drawable.draw(str);
+    expect("Square" == str.str());
+  }
+};
+
 struct Addable {
   auto add(int i) {
     return te::call<int>(
@@ -550,6 +891,92 @@ test should_support_function_lambda_expr = [] {
   }
 };
 
+struct CopyCounted {
+  static inline auto copies = 0;
+
+  CopyCounted() = default;
+  CopyCounted(const CopyCounted &) { ++copies; }
+  CopyCounted(CopyCounted &&) noexcept = default;
+};
+
+test should_support_function = [] {
+  static_assert(std::is_copy_constructible_v<te::function<int(int)>>);
+
+  te::function<int(int)> add{[](int i) { return i + 1; }};
+  auto copy = add;
+  expect(42 == add(41));
+  expect(42 == copy(41));
+
+  const auto big = std::array<int, 8>{1, 2, 3, 4, 5, 6, 7, 8};
+  te::function<int(std::size_t)> at{[big](std::size_t i) { return big[i]; }};
+  expect(8 == at(7));
+  at = [](std::size_t i) { return int(i); };
+  expect(7 == at(7));
+
+  te::function<void(CopyCounted)> sink{[](CopyCounted) {}};
+  CopyCounted::copies = 0;
+  sink(CopyCounted{});
+  expect(0 == CopyCounted::copies);
+};
+
+test should_support_move_only_function = [] {
+  static_assert(!std::is_copy_constructible_v<te::move_only_function<int()>>);
+  static_assert(std::is_nothrow_move_constructible_v<te::move_only_function<int()>>);
+
+  te::move_only_function<int()> get{[value = std::make_unique<int>(42)] { return *value; }};
+  auto moved = std::move(get);
+  expect(42 == moved());
+
+  moved = [] { return 43; };
+  expect(43 == moved());
+};
+
+int twice(int i) { return 2 * i; }
+
+test should_support_function_ref = [] {
+  using ref_t = te::function_ref<int(int)>;
+  static_assert(sizeof(ref_t) == 2 * sizeof(void *));
+  static_assert(std::is_trivially_copyable_v<ref_t>);
+
+  auto calls = 0;
+  auto count = [&calls](int i) { ++calls; return i; };
+  ref_t ref{count};
+  auto copy = ref;
+  expect(42 == ref(42) and 43 == copy(43) and 2 == calls);
+
+  expect(42 == ref_t{twice}(21));
+  expect(42 == ref_t{&twice}(21));
+  expect(42 == [](ref_t f) { return f(41); }([](int i) { return i + 1; }));
+
+  te::function_ref<void(CopyCounted)> sink{[](CopyCounted) {}};
+  CopyCounted::copies = 0;
+  sink(CopyCounted{});
+  expect(0 == CopyCounted::copies);
+};
+
+test should_support_poly_ref = [] {
+  static_assert(sizeof(te::poly_ref<Drawable>) == 2 * sizeof(void *));
+  static_assert(std::is_trivially_copyable_v<te::poly_ref<Drawable>>);
+
+  const auto draw = [](te::poly_ref<Drawable> drawable) {
+    std::stringstream str{};
+    drawable.draw(str);
+    return str.str();
+  };
+
+  static_assert(!std::is_constructible_v<te::poly_ref<Drawable>, const Circle &>);
+
+  Square square{};
+  Circle circle{};
+  te::poly_ref<Drawable> ref{square};
+  auto copy = ref;
+  expect("Square" == draw(ref) and "Square" == draw(copy));
+  expect("Circle" == draw(circle));
+
+  ref = circle;
+  expect("Circle" == draw(ref));
+};
+
 class Ctor;
 class CopyCtor;
 class MoveCtor;
@@ -689,14 +1116,14 @@ test should_support_sbo_storage_small = [] {
     storage storage3{std::move(storage2)};
     expect(1 == Storage::calls<Ctor>());
     expect(2 == Storage::calls<CopyCtor>());
-    expect(1 == Storage::calls<MoveCtor>()); //sbo success so value is moved
+    expect(0 == Storage::calls<MoveCtor>()); //move may throw, so it's on the heap and the pointer is moved
     expect(0 == Storage::calls<Dtor>());
   }
 
   expect(1 == Storage::calls<Ctor>());
   expect(2 == Storage::calls<CopyCtor>());
-  expect(1 == Storage::calls<MoveCtor>());
-  expect(4 == Storage::calls<Dtor>()); //sbo success so all values got destructed
+  expect(0 == Storage::calls<MoveCtor>());
+  expect(3 == Storage::calls<Dtor>()); //on the heap so only 3 values got destructed
 };
 
 test should_support_sbo_storage_large = [] {
@@ -773,6 +1200,305 @@ test should_support_shared_storage = [] {
   expect(2 == Storage::calls<Dtor>());
 };
 
+#if defined(__cpp_lib_memory_resource)
+class counting_resource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations{};
+  std::size_t deallocations{};
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *ptr, std::size_t bytes,
+                     std::size_t alignment) override {
+    ++deallocations;
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+test should_support_allocator_storage = [] {
+  counting_resource resource{};
+  counting_resource other_resource{};
+
+  {
+    te::poly<Addable, te::pmr_storage> addable{std::allocator_arg, &resource,
+                                               Calc{2}};
+    expect(1 == resource.allocations);
+    expect(44 == addable.add(40, 2));
+
+    te::poly<Addable, te::pmr_storage> copy{addable};
+    expect(2 == resource.allocations);
+    expect(44 == copy.add(40, 2));
+
+    te::poly<Addable, te::pmr_storage> move{std::move(copy)};
+    expect(2 == resource.allocations);
+    expect(44 == move.add(40, 2));
+
+    te::poly<Addable, te::pmr_storage> other{std::allocator_arg,
+                                             &other_resource, Calc{4}};
+    expect(1 == other_resource.allocations);
+    other = addable;
+    expect(1 == other_resource.deallocations);
+    expect(3 == resource.allocations);
+    expect(44 == other.add(40, 2));
+  }
+
+  expect(resource.allocations == resource.deallocations);
+  expect(other_resource.allocations == other_resource.deallocations);
+
+  {
+    te::poly<Addable, te::allocator_storage<>> addable{Calc{2}};
+    te::poly<Addable, te::allocator_storage<>> copy{addable};
+    expect(44 == copy.add(40, 2));
+  }
+};
+#endif
+
+test should_support_pooled_storage = [] {
+  using drawable_t = te::poly<Drawable, te::pooled_storage>;
+
+  {
+    const auto stats = te::pooled_storage::stats();
+    { drawable_t drawable{Square{}}; }
+    { drawable_t drawable{Circle{}}; }
+    expect(stats.allocations + 2 == te::pooled_storage::stats().allocations);
+    expect(stats.reuses + 1 <= te::pooled_storage::stats().reuses);
+  }
+
+  {
+    drawable_t drawable{Square{}};
+    drawable_t copy{drawable};
+    drawable = Circle{};
+
+    std::stringstream str{};
+    drawable.draw(str);
+    copy.draw(str);
+    expect("CircleSquare" == str.str());
+  }
+
+  {
+    const auto stats = te::pooled_storage::stats();
+    std::vector<drawable_t> drawables{};
+    std::thread{[&] {
+      for (auto i = 0; i < 42; ++i) {
+        drawables.emplace_back(Square{});
+      }
+    }}.join();
+
+    drawables.clear();
+    expect(stats.deallocations == te::pooled_storage::stats().deallocations);
+  }
+
+  {
+    const auto stats = te::pooled_storage::stats();
+    std::vector<drawable_t> drawables{};
+    for (auto i = 0; i < 42; ++i) {
+      drawables.emplace_back(Square{});
+    }
+    std::thread{[drawables = std::move(drawables)]() mutable {
+      drawables.clear();
+    }}.join();
+
+    drawable_t drawable{Square{}};
+    expect(stats.remote_deallocations + 42 ==
+           te::pooled_storage::stats().remote_deallocations);
+  }
+
+  {
+    struct at_exit {
+      ~at_exit() {
+        drawable_t drawable{Circle{}};
+        drawable.draw(*str);
+        *kept = drawable;
+      }
+      std::stringstream *str;
+      drawable_t *kept;
+    };
+
+    std::stringstream str{};
+    drawable_t kept{Square{}};
+    std::thread{[&] {
+      thread_local at_exit exit{&str, &kept};
+      drawable_t drawable{Square{}};
+    }}.join();
+
+    kept.draw(str);
+    expect("CircleCircle" == str.str());
+  }
+};
+
+test should_count_instrumented_calls = [] {
+  using drawable_t = te::poly<Drawable, te::dynamic_storage, te::instrumented_vtable<1>>;
+
+  std::stringstream str{};
+  drawable_t drawable{Square{}};
+  drawable.draw(str);
+  drawable.draw(str);
+
+  std::thread{[&] {
+    drawable_t other{Circle{}};
+    other.draw(str);
+  }}.join();
+
+  const auto stats = te::stats<Drawable>();
+  expect(not stats.empty());
+  expect(3 == stats[0].calls);
+  expect(3 == stats[0].samples);
+
+  auto sampled = 0u;
+  for (auto samples : stats[0].histogram) {
+    sampled += samples;
+  }
+  expect(3 == sampled);
+  expect("SquareSquareCircle" == str.str());
+};
+
+struct BigSquare : Square {
+  char data[32]{};
+};
+
+test should_name_erased_types = [] {
+  expect(std::string_view{"int"} == te::detail::type_name<int>());
+  expect(std::string_view{"Square"} == te::detail::type_name<Square>());
+  expect(std::string_view{"BigSquare"} == te::detail::type_name<BigSquare>());
+  static_assert(te::detail::type_name<Square>() == te::detail::type_name<Square>());
+};
+
+test should_record_storage_telemetry = [] {
+  static_assert(te::fits_inline_v<te::poly<Drawable, te::sbo_storage<8>>, Square>);
+  static_assert(!te::fits_inline_v<te::poly<Drawable, te::sbo_storage<8>>, BigSquare>);
+  static_assert(te::fits_inline_v<te::poly<Drawable, te::local_storage<16>>, Square>);
+  static_assert(te::fits_inline_v<te::poly<Drawable>, Square>);
+  static_assert(!te::fits_inline_v<te::poly<Drawable>, BigSquare>);
+  static_assert(!te::fits_inline_v<te::poly<Drawable>, CountedSquare>);
+  static_assert(te::fits_inline_v<Shape, Circle>);
+  static_assert(!te::fits_inline_v<Shape, BigSquare>);
+
+  using drawable_t = te::poly<Drawable, te::telemetry_storage<te::sbo_storage<8>>>;
+  static_assert(te::fits_inline_v<drawable_t, Square>);
+
+  drawable_t square{Square{}};
+  drawable_t big{BigSquare{}};
+  auto copy = square;
+  auto moved = std::move(copy);
+
+  std::stringstream str{};
+  moved.draw(str);
+  big.draw(str);
+  expect("SquareSquare" == str.str());
+
+  const auto find = [](const char *type) {
+    for (const auto &telemetry : te::telemetry<te::sbo_storage<8>>()) {
+      if (not std::strcmp(telemetry.type, type)) {
+        return telemetry;
+      }
+    }
+    return te::type_telemetry{};
+  };
+
+  const auto square_telemetry = find(te::detail::type_name<Square>());
+  expect(2 == square_telemetry.inline_placements);
+  expect(0 == square_telemetry.heap_placements);
+  expect(0 == square_telemetry.bytes_allocated);
+  expect(1 == square_telemetry.copies);
+  expect(1 == square_telemetry.moves);
+
+  const auto big_telemetry = find(te::detail::type_name<BigSquare>());
+  expect(0 == big_telemetry.inline_placements);
+  expect(1 == big_telemetry.heap_placements);
+  expect(sizeof(BigSquare) == big_telemetry.bytes_allocated);
+};
+
+struct alignas(16) AlignedSquare : Square {
+  float data[4]{};
+};
+
+test should_size_storages_for_the_implementations = [] {
+  using sbo_t = te::sbo_storage_for<Square, BigSquare, AlignedSquare>;
+  static_assert(std::is_same_v<te::sbo_storage<sizeof(BigSquare), 16>, sbo_t>);
+  static_assert(te::fits_inline_v<te::poly<Drawable, sbo_t>, BigSquare>);
+  static_assert(te::fits_inline_v<te::poly<Drawable, sbo_t>, AlignedSquare>);
+
+  using local_t = te::local_storage_for<Square, Circle>;
+  static_assert(std::is_same_v<te::local_storage<1, 1>, local_t>);
+
+  std::vector<te::poly<Drawable, sbo_t>> drawables{};
+  drawables.push_back(Square{});
+  drawables.push_back(BigSquare{});
+  drawables.push_back(AlignedSquare{});
+
+  std::stringstream str{};
+  for (const auto &drawable : drawables) {
+    drawable.draw(str);
+  }
+  expect("SquareSquareSquare" == str.str());
+
+  te::poly<Drawable, local_t> drawable{Circle{}};
+  drawable.draw(str);
+  expect("SquareSquareSquareCircle" == str.str());
+};
+
+struct alignas(64) CachelineSquare {
+  void draw(std::ostream &out) const {
+    out << (reinterpret_cast<std::uintptr_t>(this) % alignof(CachelineSquare));
+  }
+  char data{};
+};
+
+template <class TStorage>
+void expect_aligned() {
+  std::vector<te::poly<Drawable, TStorage>> drawables{};
+  for (auto i = 0; i < 8; ++i) {
+    drawables.push_back(CachelineSquare{});
+  }
+  auto copy = drawables;
+  auto moved = std::move(copy);
+
+  std::stringstream str{};
+  for (const auto &drawable : moved) {
+    drawable.draw(str);
+  }
+  expect("00000000" == str.str());
+}
+
+test should_support_over_aligned_types = [] {
+  static_assert(te::fits_inline_v<te::poly<Drawable, te::local_storage<64, 64>>, CachelineSquare>);
+  static_assert(te::fits_inline_v<te::poly<Drawable, te::sbo_storage<64, 64>>, CachelineSquare>);
+  static_assert(!te::fits_inline_v<te::poly<Drawable, te::sbo_storage<64>>, CachelineSquare>);
+
+  expect_aligned<te::local_storage<64, 64>>();
+  expect_aligned<te::sbo_storage<64, 64>>();
+  expect_aligned<te::sbo_storage<64>>();
+  expect_aligned<te::dynamic_storage>();
+  expect_aligned<te::shared_storage>();
+  expect_aligned<te::allocator_storage<>>();
+  expect_aligned<te::pooled_storage>();
+};
+
+test should_align_polys_to_a_cacheline = [] {
+  using drawable_t = te::poly<Drawable, te::cacheline_storage>;
+  static_assert(64 == sizeof(drawable_t));
+  static_assert(64 == alignof(drawable_t));
+  static_assert(te::fits_inline_v<drawable_t, Square>);
+
+  std::array<drawable_t, 2> drawables{Square{}, Circle{}};
+  expect(0 == reinterpret_cast<std::uintptr_t>(&drawables[1]) % 64);
+
+  std::stringstream str{};
+  swap(drawables[0], drawables[1]);
+  for (const auto &drawable : drawables) {
+    drawable.draw(str);
+  }
+  expect("CircleSquare" == str.str());
+};
+
 test should_support_custom_storage = [] {
   {
     te::poly<Addable> addable_def{Calc{}};
@@ -819,6 +1545,311 @@ test should_support_custom_storage = [] {
   }
 };
 
+test should_adopt_smart_pointers = [] {
+  CountedSquare::copies = CountedSquare::moves = 0;
+  auto unique = std::make_unique<CountedSquare>();
+  const auto *address = unique.get();
+  te::poly<Drawable> adopted{std::move(unique)};
+  expect(not unique);
+  expect(0 == CountedSquare::copies and 0 == CountedSquare::moves);
+
+  std::stringstream str{};
+  adopted.draw(str);
+  expect("Square" == str.str());
+
+  expect(not std::move(adopted).into_unique<Circle>());
+  auto released = std::move(adopted).into_unique<CountedSquare>();
+  expect(address == released.get());
+
+  auto shared = std::make_shared<CountedSquare>();
+  te::poly<Drawable, te::shared_storage> sharing{shared};
+  te::poly<Drawable, te::shared_storage> copy{sharing};
+  expect(3 == shared.use_count());
+
+  struct Pair {
+    Circle circle;
+    Square square;
+  };
+  auto pair = std::make_shared<Pair>();
+  te::poly<Drawable, te::shared_storage> aliasing{
+      std::shared_ptr<Square>{pair, &pair->square}};
+  expect(2 == pair.use_count());
+
+  te::poly<Drawable, te::shared_storage> from_unique{std::make_unique<Circle>()};
+  aliasing.draw(str);
+  from_unique.draw(str);
+  sharing.draw(str);
+  expect("SquareSquareCircleSquare" == str.str());
+  expect(0 == CountedSquare::copies and 0 == CountedSquare::moves);
+};
+
+struct Polygon {
+  virtual ~Polygon() = default;
+  virtual void draw(std::ostream &out) const = 0;
+};
+
+struct Hexagon : Polygon {
+  void draw(std::ostream &out) const override { out << "Hexagon"; }
+  std::array<char, 64> padding{};
+};
+
+test should_adopt_unique_pointers_to_a_base = [] {
+  te::poly<Drawable> adopted{std::unique_ptr<Polygon>{std::make_unique<Hexagon>()}};
+  std::stringstream str{};
+  adopted.draw(str);
+  expect("Hexagon" == str.str());
+
+  try {
+    te::poly<Drawable> copy{adopted};
+    expect(false);
+  } catch (const std::runtime_error &) {
+  }
+
+  te::poly<Drawable, te::sbo_storage<128>> converted{std::move(adopted)};
+  converted.draw(str);
+  expect("HexagonHexagon" == str.str());
+
+  te::poly<Drawable> released{std::unique_ptr<Polygon>{std::make_unique<Hexagon>()}};
+  expect(nullptr != std::move(released).into_unique<Polygon>());
+
+  try {
+    te::poly<Drawable, te::unique_storage> null{std::unique_ptr<Square>{}};
+    expect(false);
+  } catch (const std::runtime_error &) {
+  }
+};
+
+struct LockedSquare {
+  explicit LockedSquare(int side) : side{side} {}
+  LockedSquare(const LockedSquare &) = delete;
+  LockedSquare(LockedSquare &&) = delete;
+
+  void draw(std::ostream &out) const {
+    std::lock_guard<std::mutex> lock{mutex};
+    out << "Square" << side;
+  }
+
+  mutable std::mutex mutex{};
+  std::atomic<int> side{};
+};
+
+template <class TStorage>
+void in_place_construction() {
+  te::poly<Drawable, TStorage> drawable{std::in_place_type<LockedSquare>, 4};
+
+  std::stringstream str{};
+  drawable.draw(str);
+  expect("Square4" == str.str());
+
+  CountedSquare::copies = CountedSquare::moves = 0;
+  drawable.template emplace<CountedSquare>();
+  drawable.draw(str);
+  expect(0 == CountedSquare::copies and 0 == CountedSquare::moves);
+
+  auto &locked = drawable.template emplace<LockedSquare>(2);
+  locked.side = 3;
+  drawable.draw(str);
+  expect("Square4SquareSquare3" == str.str());
+}
+
+test should_keep_immovable_types_on_the_heap = [] {
+  static_assert(not te::is_trivially_relocatable_v<std::mutex>);
+  static_assert(not te::is_trivially_relocatable_v<LockedSquare>);
+  static_assert(not te::fits_inline_v<te::poly<Drawable, te::sbo_storage<128>>, LockedSquare>);
+  static_assert(not te::fits_inline_v<te::poly<Drawable, te::local_storage<128>>, LockedSquare>);
+
+  std::vector<te::poly<Drawable, te::sbo_storage<128>>> drawables{};
+  for (auto i = 0; i < 64; ++i) {
+    drawables.emplace_back(std::in_place_type<LockedSquare>, i);
+  }
+
+  std::stringstream str{};
+  drawables[63].draw(str);
+  expect("Square63" == str.str());
+};
+
+test should_construct_in_place = [] {
+  in_place_construction<te::dynamic_storage>();
+  in_place_construction<te::shared_storage>();
+  in_place_construction<te::sbo_storage<128>>();
+  in_place_construction<te::sbo_storage<8>>();
+  in_place_construction<te::allocator_storage<>>();
+  in_place_construction<te::pooled_storage>();
+  in_place_construction<te::telemetry_storage<te::sbo_storage<128>>>();
+};
+
+struct SidedSquare {
+  void draw(std::ostream &out) const { out << "Square" << side; }
+  std::string side{};
+};
+
+template <class TStorage>
+void reassignment() {
+  te::poly<Drawable, TStorage> drawable{SidedSquare{"1"}};
+  te::poly<Drawable, TStorage> other{SidedSquare{"2"}};
+
+  std::stringstream str{};
+  drawable = SidedSquare{"3"};
+  drawable.draw(str);
+  drawable = other;
+  drawable.draw(str);
+  drawable = te::poly<Drawable, TStorage>{SidedSquare{"4"}};
+  drawable.draw(str);
+  drawable = Circle{};
+  drawable.draw(str);
+  drawable = SidedSquare{"5"};
+  drawable.draw(str);
+  other.draw(str);
+  expect("Square3Square2Square4CircleSquare5Square2" == str.str());
+}
+
+test should_reassign_in_place = [] {
+  reassignment<te::dynamic_storage>();
+  reassignment<te::local_storage<64>>();
+  reassignment<te::sbo_storage<64>>();
+  reassignment<te::sbo_storage<8>>();
+  reassignment<te::telemetry_storage<te::dynamic_storage>>();
+  reassignment<te::shared_storage>();
+};
+
+struct HandleSquare {
+  void draw(std::ostream &out) const { out << "Square" << handle; }
+  int handle{};
+};
+
+struct ThrowingCopySquare {
+  ThrowingCopySquare() = default;
+  ThrowingCopySquare(const ThrowingCopySquare &) { throw std::runtime_error{"copy"}; }
+  ThrowingCopySquare(ThrowingCopySquare &&) { throw std::runtime_error{"move"}; }
+
+  void draw(std::ostream &out) const { out << "Square"; }
+};
+
+template <class TStorage>
+void throwing_assignment() {
+  te::poly<Drawable, TStorage> drawable{HandleSquare{7}};
+
+  auto thrown = 0;
+  try {
+    drawable = ThrowingCopySquare{};
+  } catch (const std::runtime_error &) {
+    ++thrown;
+  }
+  try {
+    drawable.template emplace<ThrowingCopySquare>(ThrowingCopySquare{});
+  } catch (const std::runtime_error &) {
+    ++thrown;
+  }
+  expect(2 == thrown);
+
+  std::stringstream str{};
+  drawable.draw(str);
+  expect("Square7" == str.str());
+}
+
+test should_keep_the_object_when_assignment_throws = [] {
+  throwing_assignment<te::dynamic_storage>();
+  throwing_assignment<te::local_storage<16>>();
+  throwing_assignment<te::sbo_storage<64>>();
+  throwing_assignment<te::sbo_storage<16>>();
+  throwing_assignment<te::pooled_storage>();
+  throwing_assignment<te::allocator_storage<>>();
+};
+
+test should_store_small_trivial_types_inline = [] {
+  te::poly<Drawable> drawable{HandleSquare{42}};
+  auto copy = drawable;
+  auto moved = std::move(copy);
+  drawable = HandleSquare{43};
+
+  std::stringstream str{};
+  drawable.draw(str);
+  moved.draw(str);
+  expect("Square43Square42" == str.str());
+
+  auto unique = std::move(moved).into_unique<HandleSquare>();
+  expect(unique and 42 == unique->handle);
+
+  te::poly<Drawable, te::shared_storage> shared{Square{}};
+  auto shared_copy = shared;
+  shared_copy.draw(str);
+  expect("Square43Square42Square" == str.str());
+};
+
+template <class TStorage>
+void move_only_storage() {
+  static_assert(!std::is_copy_constructible_v<te::poly<Drawable, TStorage>>);
+  static_assert(!std::is_copy_assignable_v<te::poly<Drawable, TStorage>>);
+  static_assert(std::is_nothrow_move_constructible_v<te::poly<Drawable, TStorage>>);
+
+  te::poly<Drawable, TStorage> drawable{SquareNoncopyable{}};
+  auto moved = std::move(drawable);
+  drawable = std::move(moved);
+
+  std::stringstream str{};
+  drawable.draw(str);
+  drawable = Circle{};
+  drawable.draw(str);
+  drawable.template emplace<LockedSquare>(1);
+  drawable.draw(str);
+  expect("SquareCircleSquare1" == str.str());
+}
+
+test should_support_move_only_storages = [] {
+  move_only_storage<te::unique_storage>();
+  move_only_storage<te::unique_sbo_storage<64>>();
+  move_only_storage<te::unique_sbo_storage<1>>();
+
+  te::poly<Drawable, te::unique_storage> adopted{std::make_unique<Square>()};
+  te::poly<Drawable, te::unique_sbo_storage<16>> converted{te::poly<Drawable>{Circle{}}};
+  static_assert(!std::is_constructible_v<te::poly<Drawable>, const decltype(converted)&>);
+  static_assert(!std::is_constructible_v<te::poly<Drawable>, decltype(converted)&&>);
+  te::poly<Drawable, te::unique_storage> moved{std::move(converted)};
+
+  std::stringstream str{};
+  adopted.draw(str);
+  moved.draw(str);
+  expect("SquareCircle" == str.str());
+
+  static_assert(!std::is_copy_constructible_v<te::move_only_function<void()>>);
+};
+
+struct WideSquare : Square {
+  std::array<char, 64> padding{};
+};
+
+test should_convert_between_storages = [] {
+  CountedSquare::copies = CountedSquare::moves = 0;
+  te::poly<Drawable, te::local_storage<16>> local{CountedSquare{}};
+  expect(0 == CountedSquare::copies and 1 == CountedSquare::moves);
+
+  te::poly<Drawable> copied{local};
+  expect(1 == CountedSquare::copies and 1 == CountedSquare::moves);
+
+  te::poly<Drawable, te::sbo_storage<16>> moved{std::move(local)};
+  expect(1 == CountedSquare::copies and 2 == CountedSquare::moves);
+
+  te::poly<Drawable, te::shared_storage> shared{std::move(moved)};
+  expect(1 == CountedSquare::copies and 3 == CountedSquare::moves);
+
+  std::stringstream str{};
+  copied.draw(str);
+  shared.draw(str);
+  expect("SquareSquare" == str.str());
+
+  te::poly<Drawable, te::sbo_storage<16>> wide{WideSquare{}};
+  expect(not te::fits_inline_v<te::poly<Drawable, te::local_storage<16>>, WideSquare>);
+  try {
+    te::poly<Drawable, te::local_storage<16>> too_small{wide};
+    expect(false);
+  } catch (const std::runtime_error &) {
+  }
+
+  te::function<int(int)> add{[](int i) { return i + 1; }};
+  te::function<int(int), te::dynamic_storage> heap{std::move(add)};
+  expect(42 == heap(41));
+};
+
 struct DrawableMutable : te::poly<DrawableMutable, te::non_owning_storage> {
   using te::poly<DrawableMutable, te::non_owning_storage>::poly;
 